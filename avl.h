@@ -17,6 +17,79 @@
 
 /*
 * C++14ϵĻб뱾Դ롣
+* Revision 25 By Lucas.
+* ޵򻺴ģʽset_capacity(size_type, avl_eviction)ʹԪظʱ
+* ͬһpuṱСʹãCLOCKλԪأͳСδ̭
+* Revision 24 By Lucas.
+* ޸ĵϲȡΪ_avl_merge_changes
+* durable_avl.hԤд־ʵֱȫĳ־ûǰˡ
+* Revision 23 By Lucas.
+* ˰޸Ԫصupdate(const_iterator, const T&)modify(const_iterator, F)
+* ֵλǰ֮ʱ͵ظдժ½ڵԭλóָң¹һУ·䡣
+* Revision 22 By Lucas.
+* ˿ѡĳԱset_membership_filter(double, size_type)֮ǰȲѯֿ鲼¡
+* һڵֵɾµĹλڻ۵һ̶ʱ޸Ĳؽ
+* Revision 21 By Lucas.
+* תƽĺ㷨ȡΪڴĺģ壬
+* C++20AVL_CONSTEXPRΣڱֵstatic_avl.h̶İ汾
+* Revision 20 By Lucas.
+* תеָĲȡΪ_avl_rotate_right_avl_rotate_left
+* avl_sequence.hСλ
+* Revision 19 By Lucas.
+* relayout(avl_layout)defragment(size_type)ڵ㰴van Emde Boas˳
+* ƵڴУָ޸֮ҵľֲԣlocality()ǰľֲԡ
+* Revision 18 By Lucas.
+* ˿ѡɢset_hash_index(double)ԿѰַɢбֵӳ䵽ڵ㣬
+* ֵɾԸڵ½ɡ
+* Revision 17 By Lucas.
+* ˰汾ѡ޸־delta_sinceĳһ汾ֵ򡢺ϲ
+* apply_deltaӦõһ׷ϵĴֻ޸ĵĶйء
+* Revision 16 By Lucas.
+* м¼ҵĽڵ㣬begin()front()back()ԼβݼΪO(1)
+* pop_front()pop_back()ʾend()ԪʱҲ½
+* Revision 15 By Lucas.
+* ƽģBĬϵavl_strict_balanceԭAVL
+* avl_weak_balanceAVLɾʱתΣ
+* avl_relaxed_balanceɾʱṹɾۻһ̶ʱؽ
+* benchmark/balance_bench.cppиԵĶԱȡ
+* Revision 14 By Lucas.
+* avl_parallel.hл빤ȡ̳߳صĲбԼ
+* Revision 13 By Lucas.
+* lower_bound(const T&)sharded_avl.hаƬĲ
+* Revision 12 By Lucas.
+* put_sortedɾremove_sorted
+* Сʱһλָңϴʱ鲢ؽ
+* buffered_avl.hддǰˡ
+* Revision 11 By Lucas.
+* ˶ɾģʽɾֻڵΪĹĹ
+* ĹֵʱO(n)ĴؽĹ
+* Revision 10 By Lucas.
+* ʹĬϱȽͣʱֵݼÿֻȽһβԱȽϽѡ
+* Revision 9 By Lucas.
+* Ƚϸ_avl_key_traits<T, C>ɡʹĬϱȽstd::string
+* ڵڻǰ8ֽڣʱ½繲еǰ׺һαȽֻһcompare
+* Revision 8 By Lucas.
+* ˰ɾerase(const_iterator)ɾerase(const_iterator, const_iterator)
+* Լνɾerase_if(P)
+* ɾָϲɣɾɾ϶ʱO(n)Ĵؽ
+* Revision 7 By Lucas.
+* Ϊǵݹʵ֣²Ҳλã¶ϻݵƽ⡣
+* ˴ʾĲput(const_iterator, const T&)emplace_hint
+* ԼصĲlocate(const T&)ʹеָҡ
+* Revision 6 By Lucas.
+* clear()ٵݹͷŽڵ㡣TƽʱֻͷŽڵء
+* ˺̨ģʽclear()O(1)ʱڷء
+* Revision 5 By Lucas.
+* ڵΪÿеĽڵз䡣
+* Ϊǵݹʵ֣нڵԤȷһڴУ
+* ޸˿ʱʿָbug
+* clone(std::size_t)ӿڣʹö̲߳иƴ
+* Revision 4 By Lucas.
+* ͳƲģSĬϵavl_no_statsκο
+* avl_counting_statsռȽϡתݡԼƽֱͼ
+* ޸R-Lתƽӵļ
+* ޸˵ֻеĽڵƶ⡣
+* дɾĻݹ̣ʹƽɾ󱣳ȷ
 * Revision 3 By Lucas.
 * ޸˶Կbegin()ʱڴ쳣ʵbug
 * ޸˱Ƚʵ߼ٲɾıȽϴ
@@ -37,1134 +110,5009 @@
 #include <cstddef>
 #include <exception>
 #include <iterator>
+#include <functional>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
 
-// ͵ǰ
-template <typename T, typename C>
-class _avl_iterator;
+/*
+ * AVL_CONSTEXPRC++20ϵĻչΪconstexprΪա
+ * βڴĺ㷨תƽ
+ * ʹڱֵstatic_avl.hC++14C++17ճʹá
+ */
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define AVL_CONSTEXPR constexpr
+#else
+#define AVL_CONSTEXPR
+#endif
 
 /*
- * class template avlAVLƽ
- * ģ˵
- * TͣҪ˲֧operator<Ĭ
- * ԶȽͬʱп
- * CȽͣĬΪstd::less<T>
- * ñȽʹToperator<ɱȽϡ
+ * enum avl_rotationתࡣ
+ * ȡֵavl_stats_snapshot::rotations±ꡣ
  */
-template <typename T, typename C = std::less<T>>
-class avl final {
-	// Ե͵Ԫ
-	friend class _avl_iterator<T, C>;
-	// ˽ʵֲ֡
+enum avl_rotation : std::size_t {
+	avl_rotate_ll = 0,
+	avl_rotate_rr = 1,
+	avl_rotate_lr = 2,
+	avl_rotate_rl = 3
+};
+
+/*
+ * enum avl_operationͳƲ¼Ĳࡣ
+ */
+enum avl_operation : std::size_t {
+	avl_op_insert = 0,
+	avl_op_find = 1,
+	avl_op_remove = 2
+};
+
+// ֱͼͰAVLĸ߶Ȳ1.44log(n)64Ͱ㹻ʹá
+constexpr std::size_t avl_stats_depth_buckets = 64;
+
+/*
+ * struct avl_stats_snapshotAVLڲͳݵĿա
+ * ɹӿavl<T, C, S, B>::stats()ɣⲿָ굼ȡ
+ * Ա˵
+ * operationsĴavl_operationΪ±ꡣ
+ * comparisons_compareĵô·ȽϵĴ
+ * rotationsתĴavl_rotationΪ±ꡣ
+ * retracesretrace_stepsmax_retrace
+ * ɾݵĴݾĽڵ͵λݵȡ
+ * allocationsdeallocationsڵķͷŴ
+ * sizeheightʱAVLĴС߶ȡ
+ * depth_histogramÿβĽڵֱͼΧ߼һͰ
+ * factor_histogramʱƽΪ-101Ľڵ
+ * sizeheightfactor_histogram⣬ֶδͳʱΪ0
+ * ṹֶΣsizeheightfactor_histogramavlɿʱֳ㣬
+ * ͳƲֻ֡
+ */
+struct avl_stats_snapshot {
+	std::uint64_t operations[3] = {};
+	std::uint64_t comparisons = 0;
+	std::uint64_t rotations[4] = {};
+	std::uint64_t retraces = 0;
+	std::uint64_t retrace_steps = 0;
+	std::uint64_t max_retrace = 0;
+	std::uint64_t allocations = 0;
+	std::uint64_t deallocations = 0;
+	std::size_t size = 0;
+	std::size_t tombstones = 0;
+	std::size_t height = 0;
+	std::uint64_t depth_histogram[avl_stats_depth_buckets] = {};
+	std::uint64_t factor_histogram[3] = {};
+};
+
+/*
+ * class avl_no_statsĬϵͳƲԣռκݡ
+ * йӾΪյavlԼ̳еķʽʹòԣ
+ * ջŻòԲռÿռҲκʱ
+ */
+class avl_no_stats {
+protected:
+	void _stat_compare() const {}
+	void _stat_op_begin(avl_operation) const {}
+	void _stat_op_end() const {}
+	void _stat_rotate(avl_rotation) const {}
+	void _stat_retrace(std::size_t) const {}
+	void _stat_alloc(std::size_t) const {}
+	void _stat_free(std::size_t) const {}
+	void _stat_fill(avl_stats_snapshot&) const {}
+};
+
+/*
+ * class avl_counting_statsռֱͼͳƲԡ
+ * Ϊfind()ֻӿͬҪԼΪmutable
+ * ԭӱȡʱҪAVLʹֶͬͬΡ
+ */
+class avl_counting_stats {
 private:
+	mutable avl_stats_snapshot _counters;
+	// ǰʼʱıȽϴڼ㱾βȡ
+	mutable std::uint64_t _op_mark = 0;
+
+protected:
+	void _stat_compare() const {
+		_counters.comparisons++;
+	}
+	void _stat_op_begin(avl_operation _op) const {
+		_counters.operations[_op]++;
+		_op_mark = _counters.comparisons;
+	}
+	void _stat_op_end() const {
+		// ÿ½һǡýһ·ȽϣʱȽϴ֮ΪĽڵ
+		std::uint64_t _depth = _counters.comparisons - _op_mark;
+		if (_depth >= avl_stats_depth_buckets)
+			_depth = avl_stats_depth_buckets - 1;
+		_counters.depth_histogram[_depth]++;
+	}
+	void _stat_rotate(avl_rotation _kind) const {
+		_counters.rotations[_kind]++;
+	}
+	void _stat_retrace(std::size_t _steps) const {
+		_counters.retraces++;
+		_counters.retrace_steps += _steps;
+		if (_steps > _counters.max_retrace)
+			_counters.max_retrace = _steps;
+	}
+	void _stat_alloc(std::size_t _count) const {
+		_counters.allocations += _count;
+	}
+	void _stat_free(std::size_t _count) const {
+		_counters.deallocations += _count;
+	}
+	void _stat_fill(avl_stats_snapshot& _snap) const {
+		_snap = _counters;
+	}
+
+public:
 	/*
-	 * ݽṹ_node*(typename avl<T, C>::_node*)
-	 * ʹʾʾĶеÿڵ㡣
-	 * Ա˵
-	 * valueΪconst T洢ڵֵ
-	 * leftChildrightChildΪ_node*ֱ洢Ϣ
-	 * parentΪ_node*洢ڵϢ
-	 * factorΪstd::ptrdiff_t洢ڵƽӡ
+	 *	ӿڣreset_stats()
+	 *	мֱͼ
 	 */
-	struct _node {
-		const T value;
-		_node* leftChild = nullptr;
-		_node* rightChild = nullptr;
-		_node* parent = nullptr;
-		std::ptrdiff_t factor = 0;
-		// һconst T&ΪòڳʼvalueֶΡ
-		_node(const T& _val) : value(_val) {}
-		~_node() = default;
+	void reset_stats() {
+		_counters = avl_stats_snapshot();
+		_op_mark = 0;
+	}
+};
+
+/*
+ * class template _avl_plain_lessжϱȽCǷȼڶTʹoperator<std::less
+ * ֻ£T·Ƚϻȼ۵ıȽϷʽȽ
+ */
+template <typename C, typename T>
+struct _avl_plain_less : std::integral_constant<bool,
+	std::is_same<C, std::less<T>>::value || std::is_same<C, std::less<void>>::value> {};
+
+/*
+ * class template _avl_fast_keyжTǷΪʹĬϱȽ͡
+ * TֵݱȰôݸ죬һαȽֻһָ
+ * ʱÿֻȽһΣñȽϽѡ֡ȡ
+ */
+template <typename T, typename C>
+struct _avl_fast_key : std::integral_constant<bool,
+	std::is_arithmetic<T>::value && _avl_plain_less<C, T>::value> {};
+
+/*
+ * class template _avl_key_traitsصıȽϲԡ
+ * node_baseڵĻ࣬ڽڵڴżĻϢ
+ * assignڽڵ㹹ɺдϢ
+ * probeһβдҵļԼҹл۵Ϣ
+ * compare·Ƚϣֵavl<T, C, S, B>::_compareͬ
+ * ͨð汾κϢȽΡ
+ */
+template <typename T, typename C, typename = void>
+struct _avl_key_traits {
+	struct node_base {};
+
+	static void assign(node_base&, const T&) {}
+
+	struct probe {
+		const T& key;
+		explicit probe(const T& _key) : key(_key) {}
 	};
-	// ˽ֶΣ_rootΪ_node*洢AVLĸڵ㡣
-	_node* _root;
-	// ˽ֶΣ_sizeΪstd::size_t洢AVLĴС
-	std::size_t _size;
-	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
-	C _comparator;
 
-	/*
-	 * _compare
-	 * жԪصԴС֤ȽϲΡ
-	 * ҪȽʵ֡
-	 * 
-	 * _lhsȽϵԪء
-	 * _rhsȽϵԪء
-	 * ֵint
-	 * ֵΪ-1_lhsСڡ_rhs
-	 * ֵΪ0_lhsڡ_rhs
-	 * ֵΪ1_lhsڡ_rhs
-	 */
-	int _compare(const T& _lhs, const T& _rhs) const {
-		if (_comparator(_lhs, _rhs))
+	static int compare(const C& _comp, const T& _lhs, const T& _rhs) {
+		if (_comp(_lhs, _rhs))
 			return -1;
 		else {
-			if (_comparator(_rhs, _lhs))
+			if (_comp(_rhs, _lhs))
 				return 1;
 			else
 				return 0;
 		}
 	}
 
-	/*
-	 *	avl(_node*, std::size_t, C)
-	 *	˽йṩԱʹá
-	 *	ڶAVLĸá
-	 */
-	avl(_node* _root_node, std::size_t _sz, C _comp) : _root(_root_node), _size(_sz),
-
-		_comparator(_comp) {}
-
-	// ¸䶨֮ע͡
-	void _insert_node(_node*, const T&);
-	const _node* _find_node(const _node*, const T&) const;
-	void _remove_node(_node*);
-	void _clear_tree(_node*);
-	void _make_copy(_node*&) const;
-	void _copy_node(_node*, const _node*) const;
-	void _swap_node(_node*, _node*);
-	_node* _check_tree(_node*);
-	_node* _ll_rotate(_node*);
-	_node* _rr_rotate(_node*);
-	_node* _lr_rotate(_node*);
-	_node* _rl_rotate(_node*);
-
-	/*
-	 *	_is_left_child
-	 *	жϼҳͺӵĹϵ
-	 *	
-	 *	_parentΪ_node*жϵĸڵ㡣
-	 *	_childΪ_node*жϵӽڵ㡣
-	 *	ֵboolָӽڵǸڵ
-	 *	ֵΪtrueӽڵǸڵ
-	 *	ֵΪfalseӽڵǸڵ
-	 *	ĵõ㱣֤ڵϵ
-	 *	ڵ㲻ϵݽṹѾ
-	 *	˵std::terminate()
-	 */
-	bool _is_left_child(_node* _parent, _node* _child) {
-		if (_parent->leftChild == _child)
-			return true;
-		else if (_parent->rightChild == _child)
-			return false;
-		else
-			std::terminate();
-		return false;
+	static int compare(const C& _comp, probe& _p, const node_base&, const T& _value) {
+		return compare(_comp, _p.key, _value);
 	}
+};
 
-public:
-	// Ӧͱ
-	// Ϊ_avl_iterator<T, C>̳std::iterator
-	// <std::bidirectional_iterator_tag, const T>
-	// Ϊconst_iteratorʹá
-	using size_type = std::size_t;
-	using iterator = _avl_iterator<T, C>;
-	using const_iterator = _avl_iterator<T, C>;
-	using reverse_iterator = std::reverse_iterator<_avl_iterator<T, C>>;
-	using const_reverse_iterator = std::reverse_iterator<_avl_iterator<T, C>>;
+/*
+ * _avl_key_traitsstd::stringʹĬϱȽػ
+ * ڵڴżǰ8ֽڣƴһʱ0
+ * ȽֻȽɵóۣʴڶϵַݡ
+ * ʱ¼ҵļ½ڵǰ׺
+ * ½֮ĽڵĹǰ׺̣˱ȽϿԴӸôʼ
+ * ڴгǰ׺ļURLļ·ȣʡȥظȽǰ׺Ŀ
+ */
+template <typename A, typename C>
+struct _avl_key_traits<std::basic_string<char, std::char_traits<char>, A>, C,
+	typename std::enable_if<_avl_plain_less<C, std::basic_string<char, std::char_traits<char>, A>>::value>::type> {
+	using string_type = std::basic_string<char, std::char_traits<char>, A>;
 
-	/*
-	 *	ӿڣ/ĬϹ
-	 *	ܣѡģ
-	 *	빹ĬϹһ
-	 *	ùί˽йɹ
-	 */
-	avl(C comp = C()) : avl(nullptr, 0, comp) {}
+	struct node_base {
+		std::uint64_t prefix = 0;
+	};
 
-	/*
-	 *	ӿڣ
-	 *	ø_make_copy(_node*&)ݵĸƣ
-	 *	ͬʱƱ_size_comparatorֶΡ
-	 */
-	avl(const avl& src) {
-		src._make_copy(_root);
-		_size = src._size;
-		_comparator = src._comparator;
+	// ַǰ8ֽڰƴһʱ0
+	// ǰ׺ʱСϵֵַһ¡
+	static std::uint64_t prefix_of(const string_type& _s) {
+		std::uint64_t _prefix = 0;
+		std::size_t _len = _s.size() < 8 ? _s.size() : 8;
+		for (std::size_t _i = 0; _i < 8; _i++) {
+			_prefix <<= 8;
+			if (_i < _len)
+				_prefix |= static_cast<unsigned char>(_s[_i]);
+		}
+		return _prefix;
 	}
 
-	/*
-	 *	ӿڣֵ
-	 *	ȵùӿclear()ڲݣ
-	 *	Ȼٴӱиݣ
-	 *	߼뿽ơ
-	 */
-	avl& operator=(const avl& src) {
-		clear();
-		src._make_copy(_root);
-		_size = src._size;
-		_comparator = src._comparator;
-		return *this;
+	static void assign(node_base& _base, const string_type& _value) {
+		_base.prefix = prefix_of(_value);
 	}
 
 	/*
-	 *	ӿڣƶ캯
-	 *	ƶ캯ӱƶȡݣ
-	 *	ƶڿİȫ״̬С
+	 * probeԱ˵
+	 * keyҵļ
+	 * prefixkeyǰ׺
+	 * lowerupperkey뵱ǰ½硢Ͻڵǰ׺ȡ
 	 */
-	avl(avl&& src) noexcept : avl(src._root, src._size, src._comparator) {
-		src._root = nullptr;
-		src._size = 0;
-	}
+	struct probe {
+		const string_type& key;
+		std::uint64_t prefix;
+		std::size_t lower = 0;
+		std::size_t upper = 0;
+		explicit probe(const string_type& _key) : key(_key), prefix(prefix_of(_key)) {}
+	};
 
 	/*
-	 *	ӿڣƶֵ
-	 *	߼ƶ캯ƣ
-	 *	Ҫݡ
+	 * ӵ_skipֽڿʼȽַһͬλá
+	 * ֤߱ߵǰ_skipֽͬ
 	 */
-	avl& operator=(avl&& src) noexcept {
-		clear();
-		_root = src._root;
-		_size = src._size;
-		_comparator = src._comparator;
-		src._root = nullptr;
-		src._size = 0;
-		return *this;
+	static int compare_from(const string_type& _lhs, const string_type& _rhs, std::size_t _skip, std::size_t& _mismatch) {
+		std::size_t _len = _lhs.size() < _rhs.size() ? _lhs.size() : _rhs.size();
+		const char* _a = _lhs.data();
+		const char* _b = _rhs.data();
+		std::size_t _i = _skip;
+
+		// ÿαȽ8ֽڣҵһͬĿֽڱȽϡ
+		while (_i + 8 <= _len && !std::memcmp(_a + _i, _b + _i, 8))
+			_i += 8;
+		while (_i < _len && _a[_i] == _b[_i])
+			_i++;
+		_mismatch = _i;
+		if (_i < _len)
+			return static_cast<unsigned char>(_a[_i]) < static_cast<unsigned char>(_b[_i]) ? -1 : 1;
+		if (_lhs.size() == _rhs.size())
+			return 0;
+		return _lhs.size() < _rhs.size() ? -1 : 1;
 	}
 
-	/*
-	 *	ӿڣ
-	 *	ڶʱͷݣ
-	 *	òͨùӿclear()ɡ
-	 */
-	~avl() {
-		clear();
+	static int compare(const C&, const string_type& _lhs, const string_type& _rhs) {
+		std::size_t _mismatch;
+		return compare_from(_lhs, _rhs, 0, _mismatch);
 	}
 
-	void put(const T&);
-	bool find(const T&) const;
-	bool remove(const T&);
-	void clear();
-
-	/*
-	 *	ӿڣempty()
-	 *	ޡ
-	 *	ֵboolָʾAVLǷΪա
-	 */
-	bool empty() const {
-		// ڵΪnullptrAVLΪա
-		return !static_cast<bool>(_root);
-	}
+	static int compare(const C&, probe& _p, const node_base& _base, const string_type& _value) {
+		std::size_t _skip = _p.lower < _p.upper ? _p.lower : _p.upper;
 
-	/*
-	 *	ӿڣsize()
-	 *	ޡ
-	 *	ֵtypename avl<T, C>::size_type(std::size_t)
-	 *	ָʾAVLĴС
-	 */
-	size_type size() const {
-		// Ϊڽнڵɾʱ_sizeֶξõ£
-		// Դ˽ӿڼ򵥵ط_sizeֶΡ
-		return _size;
+		// ǰ׺8ֽʱȱȽϽڵڵǰ׺
+		// ʱ֪ȷеĹǰ׺ȣԭļ¼Ȼȷޡ
+		if (_skip < 8 && _p.prefix != _base.prefix)
+			return _p.prefix < _base.prefix ? -1 : 1;
+		std::size_t _mismatch;
+		int _result = compare_from(_p.key, _value, _skip, _mismatch);
+		if (_result == -1)
+			_p.upper = _mismatch;
+		else if (_result == 1)
+			_p.lower = _mismatch;
+		return _result;
 	}
-
-	iterator begin();
-	iterator end();
-	const_iterator begin() const;
-	const_iterator end() const;
-	const_iterator cbegin() const;
-	const_iterator cend() const;
-	reverse_iterator rbegin();
-	reverse_iterator rend();
-	const_reverse_iterator rbegin() const;
-	const_reverse_iterator rend() const;
-	const_reverse_iterator crbegin() const;
-	const_reverse_iterator crend() const;
 };
 
 /*
- *	class template _avl_iteratorAVLĵ
- *	ģclass template avlһ˴׸
- *	̳std::iterator<std::bidirectional_iterator_tag, const T>,
- *	˱ǩ˫ʵԡ
+ * function template _avl_rotate_rightָĽڵִL-Lת
+ * ֻڵָ֮룬ƽϢɵ߸£
+ * ˿ɹAVLתΪãavl_sequence.h
+ * ģ˵
+ * NڵͣleftChildrightChildparentֶָΡ
+ * 
+ * _nĽڵ㣬Ϊա
+ * _rootĸڵ㣬_nΪڵʱ֮¡
+ * ֵN*תռ_nԭλõĽڵ㡣
  */
-template <typename T, typename C = std::less<T>>
-class _avl_iterator : public std::iterator<std::bidirectional_iterator_tag, const T> {
-	// ͬAVLԪȨޡ
-	friend class avl<T, C>;
-
-private:
+template <typename N>
+AVL_CONSTEXPR N* _avl_rotate_right(N* _n, N*& _root) {
 
-	// ˽ֶΣ_containerΪconst avl<T, C>*ʾ
-	const avl<T, C>* _container;
-
-	// ˽ֶΣ_valueΪconst typename avl<T, C>::_node*ʾǰָĽڵ㡣
-	const typename avl<T, C>::_node* _value;
+	// ĶĴʱʺֽ߶߶
+	// ¼_nĸڵ
+	auto _prev_parent = _n->parent;
+	auto _prev_left = _n->leftChild;
 
-	/*
-	 *	˽йָָָڵָ롣
-	 */
-	_avl_iterator(const avl<T, C>* _cont, const typename avl<T, C>::_node* _node) : _container
+	// _prev_leftĸڵΪ_prev_parent
+	_prev_left->parent = _prev_parent;
+	if (_prev_parent) {
+		if (_prev_parent->rightChild == _n) {
+			_prev_parent->rightChild = _prev_left;
+		}
+		else {
+			_prev_parent->leftChild = _prev_left;
+		}
+	}
+	else
+		_root = _prev_left;
 
-	(_cont), _value(_node) {}
+	// _nΪ_prev_left
+	_n->leftChild = _prev_left->rightChild;
+	if (_prev_left->rightChild)
+		_prev_left->rightChild->parent = _n;
 
-public:
+	// _prev_leftΪ_n
+	_n->parent = _prev_left;
+	_prev_left->rightChild = _n;
 
-	/*
-	 *	ӿڣĬϹ
-	 *	ɴ˹ĵЧڡβ
-	 */
-	_avl_iterator() : _avl_iterator(nullptr, nullptr) {}
+	// _prev_leftΪɵĽڵ㡣
+	return _prev_left;
+}
 
-	/*
-	 *	ӿڣ캯ֵ
-	 *	ṩBitwise Copy Semantics㱾Ҫ
-	 *	ƶ
-	 */
-	_avl_iterator(const _avl_iterator&) = default;
-	_avl_iterator& operator=(const _avl_iterator&) = default;
+/*
+ * function template _avl_rotate_leftָĽڵִR-Rת
+ * _avl_rotate_rightΪοԴĶ
+ */
+template <typename N>
+AVL_CONSTEXPR N* _avl_rotate_left(N* _n, N*& _root) {
+	auto _prev_parent = _n->parent;
+	auto _prev_right = _n->rightChild;
+	_prev_right->parent = _prev_parent;
+	if (_prev_parent) {
+		if (_prev_parent->rightChild == _n) {
+			_prev_parent->rightChild = _prev_right;
+		}
+		else {
+			_prev_parent->leftChild = _prev_right;
+		}
+	}
+	else
+		_root = _prev_right;
+	_n->rightChild = _prev_right->leftChild;
+	if (_prev_right->leftChild)
+		_prev_right->leftChild->parent = _n;
+	_n->parent = _prev_right;
+	_prev_right->leftChild = _n;
+	return _prev_right;
+}
+
+/*
+ * function template _avl_check_tree
+ * _nΪڵǷAVLĶ塣
+ * ִӦ
+ * ģ˵
+ * Nڵֶָͣ⻹ƽֶfactor߶ȼ߶ȣ
+ * 
+ * _nĽڵ㡣
+ * _rootĸڵ㣬תʱ֮¡
+ * _kindתʱ¼תࡣ
+ * ֵN*Ľڵ㡣δת򷵻_n
+ */
+template <typename N>
+AVL_CONSTEXPR N* _avl_check_tree(N* _n, N*& _root, avl_rotation& _kind) {
+
+	// _nƽӽе
+	// еstd::terminate()֧ʾAVLĶܵķ֧
+	switch (_n->factor) {
+	case -2: {
+
+		// _nƽΪ-2ҪR-תԱAVLʡ
+		auto _prev_r = _n->rightChild;
+		auto _prev_rl = _prev_r->leftChild;
+
+		// תֻ_nΪ޸ĸڵƽӣ
+		// ת߶Ƿ仯ɵߣɾĻݹ̣жϡ
+		// ƽӽе
+		// еƽӵΪֽ֤õĽ
+		// ʿԼ֤
+		switch (_prev_r->factor) {
+
+			// ƽΪ-1R-Rת
+		case -1:
+			_n->factor = 0;
+			_prev_r->factor = 0;
+			_kind = avl_rotate_rr;
+			return _avl_rotate_left(_n, _root);
+
+			// ƽΪ0R-LתR-Rת
+			// R-RתС˴˴ѡR-Rת
+		case 0:
+			_n->factor = -1;
+			_prev_r->factor = 1;
+			_kind = avl_rotate_rr;
+			return _avl_rotate_left(_n, _root);
+
+			// ƽΪ1R-Lת
+		case 1:
+			switch (_prev_rl->factor) {
+			case -1:
+				_n->factor = 1;
+				_prev_r->factor = _prev_rl->factor = 0;
+				break;
+			case 0:
+				_prev_r->factor = _prev_rl->factor = _n->factor = 0;
+				break;
+			case 1:
+				_prev_rl->factor = _n->factor = 0;
+				_prev_r->factor = -1;
+				break;
+			default:
+				std::terminate();
+			}
+			_kind = avl_rotate_rl;
+			_avl_rotate_right(_n->rightChild, _root);
+			return _avl_rotate_left(_n, _root);
+		default:
+			std::terminate();
+		}
+	}
+
+		   // ƽӵľֵСڵ1õ_nɡ
+	case -1:
+	case 0:
+	case 1:
+		return _n;
+
+		// ƽӵ2ҪL-ת
+		// ˲R-תΪϷcase -2Ķ
+	case 2: {
+		auto _prev_l = _n->leftChild;
+		auto _prev_lr = _prev_l->rightChild;
+		switch (_prev_l->factor) {
+		case 1:
+			_prev_l->factor = _n->factor = 0;
+			_kind = avl_rotate_ll;
+			return _avl_rotate_right(_n, _root);
+		case 0:
+			_prev_l->factor = -1;
+			_n->factor = 1;
+			_kind = avl_rotate_ll;
+			return _avl_rotate_right(_n, _root);
+		case -1:
+			switch (_prev_lr->factor) {
+			case -1:
+				_prev_l->factor = 1;
+				_prev_lr->factor = _n->factor = 0;
+				break;
+			case 0:
+				_prev_l->factor = _prev_lr->factor = _n->factor = 0;
+				break;
+			case 1:
+				_prev_l->factor = _prev_lr->factor = 0;
+				_n->factor = -1;
+				break;
+			default:
+				std::terminate();
+			}
+			_kind = avl_rotate_lr;
+			_avl_rotate_left(_n->leftChild, _root);
+			return _avl_rotate_right(_n, _root);
+		default:
+			break;
+		}
+	}
+	default:
+		break;
+	}
+	std::terminate();
+	return nullptr;
+}
+
+/*
+ * function template _avl_retrace_insert
+ * ڵӸýڵڵݣƽӲڱҪʱת
+ * ĳȵƽӱΪ0Ϊ߶Ȳ䣬ݽ
+ * Ϊ1߶1ϻݣ
+ * Ϊ2תתָǰĸ߶ȣݽ
+ * ˲ľ̯ݴΪO(1)
+ * 
+ * _n²Ľڵ㡣
+ * _rootĸڵ㡣
+ * _kindתʱ¼תࡣ
+ * ֵboolǷת
+ */
+template <typename N>
+AVL_CONSTEXPR bool _avl_retrace_insert(N* _n, N*& _root, avl_rotation& _kind) {
+	for (auto _p = _n->parent; _p; _n = _p, _p = _p->parent) {
+		if (_p->leftChild == _n)
+			_p->factor++;
+		else
+			_p->factor--;
+		if (_p->factor == 0)
+			break;
+		if (_p->factor == 2 || _p->factor == -2) {
+			_avl_check_tree(_p, _root, _kind);
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * function template _avl_find_position_avl_find_node
+ * ֻȽĲңͳƣҲʹüԤϢ
+ * _avl_find_positionȷ_valӦλã_valȡĽڵ򷵻ظýڵ㣬
+ * 򷵻ؿָ룬_parent_left½ڵĸڵ㼰䷽_parentΪʱ½ڵΪڵ㣩
+ * _avl_find_node_valȡĽڵ㣬ʱؿָ롣
+ */
+template <typename N, typename K, typename C>
+AVL_CONSTEXPR N* _avl_find_position(N* _n, const K& _val, const C& _comp, N*& _parent, bool& _left) {
+	_parent = nullptr;
+	_left = false;
+	while (_n) {
+		if (_comp(_val, _n->value))
+			_left = true;
+		else if (_comp(_n->value, _val))
+			_left = false;
+		else
+			return _n;
+		_parent = _n;
+		_n = _left ? _n->leftChild : _n->rightChild;
+	}
+	return nullptr;
+}
+
+template <typename N, typename K, typename C>
+AVL_CONSTEXPR N* _avl_find_node(N* _n, const K& _val, const C& _comp) {
+	while (_n) {
+		if (_comp(_val, _n->value))
+			_n = _n->leftChild;
+		else if (_comp(_n->value, _val))
+			_n = _n->rightChild;
+		else
+			return _n;
+	}
+	return nullptr;
+}
+
+/*
+ * function template _avl_successor_avl_predecessor
+ * ڵеĺǰʱؿָ롣
+ * ڵĽڵ㣻
+ * ظڵϻݣֱĳڵ丸ڵøڵ㼴Ϊ̡
+ * ǰ֮Ϊ
+ */
+template <typename N>
+AVL_CONSTEXPR N* _avl_successor(N* _n) {
+	N* _p = _n->rightChild;
+	if (_p) {
+		while (_p->leftChild)
+			_p = _p->leftChild;
+		return _p;
+	}
+	_p = _n;
+	while ((_p->parent) && (_p->parent->rightChild == _p))
+		_p = _p->parent;
+	return _p->parent;
+}
+
+template <typename N>
+AVL_CONSTEXPR N* _avl_predecessor(N* _n) {
+	N* _p = _n->leftChild;
+	if (_p) {
+		while (_p->rightChild)
+			_p = _p->rightChild;
+		return _p;
+	}
+	_p = _n;
+	while ((_p->parent) && (_p->parent->leftChild == _p))
+		_p = _p->parent;
+	return _p->parent;
+}
+
+/*
+ * class template _avl_node_poolAVLĽڵء
+ * ڵڴΪλϵͳڴ棬еĽڵ۰˳䣬
+ * ͷŵĽڵ۹Թãڴrelease()ʱͳһ黹
+ * ڵֻ洢ڵĹʹɡ
+ * ģ˵
+ * Nڵ͡
+ */
+template <typename N>
+class _avl_node_pool {
+private:
+	// ڵۣʱſָ룬ʹʱһڵ㡣
+	union _slot {
+		_slot* next;
+		alignas(N) unsigned char storage[sizeof(N)];
+	};
+
+	// ڴͷڵ۽š
+	struct _block {
+		_block* next;
+		std::size_t capacity;
+		std::size_t used;
+	};
+
+	// ͷռĿռ䣬ȡԱ֤ڵ۵Ķ롣
+	static constexpr std::size_t _header_size =
+		(sizeof(_block) + alignof(_slot) - 1) / alignof(_slot) * alignof(_slot);
+
+	// ĬڴС
+	static constexpr std::size_t _min_block = 16;
+
+	// ˽ֶΣ_blocksڴͷǵǰ˳ڴ顣
+	_block* _blocks = nullptr;
+	// ˽ֶΣ_freeнڵ
+	_slot* _free = nullptr;
+	// ˽ֶΣ_capacityڴĽڵ
+	std::size_t _capacity = 0;
+
+	static _slot* _slots_of(_block* _b) {
+		return reinterpret_cast<_slot*>(reinterpret_cast<unsigned char*>(_b) + _header_size);
+	}
+
+	/*
+	 *	_retire_current
+	 *	ǰڴδĽڵ۹
+	 *	ԱлµڴԿɸǡ
+	 */
+	void _retire_current() {
+		if (!_blocks)
+			return;
+		auto _slots = _slots_of(_blocks);
+		while (_blocks->used < _blocks->capacity) {
+			auto _s = _slots + _blocks->used++;
+			_s->next = _free;
+			_free = _s;
+		}
+	}
+
+	/*
+	 *	_push_block
+	 *	һ_countڵ۵ڴ飬ʹΪǰڴ顣
+	 */
+	void _push_block(std::size_t _count) {
+		auto _b = static_cast<_block*>(::operator new(_header_size + _count * sizeof(_slot)));
+		_retire_current();
+		_b->next = _blocks;
+		_b->capacity = _count;
+		_b->used = 0;
+		_blocks = _b;
+		_capacity += _count;
+	}
+
+public:
+	_avl_node_pool() = default;
+	_avl_node_pool(const _avl_node_pool&) = delete;
+	_avl_node_pool& operator=(const _avl_node_pool&) = delete;
+
+	_avl_node_pool(_avl_node_pool&& _src) noexcept
+		: _blocks(_src._blocks), _free(_src._free), _capacity(_src._capacity) {
+		_src._blocks = nullptr;
+		_src._free = nullptr;
+		_src._capacity = 0;
+	}
+
+	_avl_node_pool& operator=(_avl_node_pool&& _src) noexcept {
+		swap(_src);
+		_src.release();
+		return *this;
+	}
+
+	~_avl_node_pool() {
+		release();
+	}
+
+	/*
+	 *	ӿڣallocate()
+	 *	ֵvoid*һδĽڵۡ
+	 *	ȸÿеĽڵۣڵǰڴ˳䣬
+	 *	߾һµڴ飬ɱ
+	 */
+	void* allocate() {
+		if (_free) {
+			auto _s = _free;
+			_free = _s->next;
+			return _s->storage;
+		}
+		if (!_blocks || _blocks->used == _blocks->capacity)
+			_push_block(_capacity > _min_block ? _capacity : _min_block);
+		return _slots_of(_blocks)[_blocks->used++].storage;
+	}
+
+	/*
+	 *	ӿڣallocate_sequential()
+	 *	allocate()ͬʹÿڵǰڴ˳䣬
+	 *	ɴεõõĽڵڴڵġ
+	 */
+	void* allocate_sequential() {
+		if (!_blocks || _blocks->used == _blocks->capacity)
+			_push_block(_capacity > _min_block ? _capacity : _min_block);
+		return _slots_of(_blocks)[_blocks->used++].storage;
+	}
+
+	/*
+	 *	ӿڣdeallocate(void*)
+	 *	һģڵ۹黹ڵء
+	 */
+	void deallocate(void* _p) {
+		auto _s = reinterpret_cast<_slot*>(_p);
+		_s->next = _free;
+		_free = _s;
+	}
+
+	/*
+	 *	ӿڣreserve(std::size_t)
+	 *	һǡú_countڵ۵ڴ飬
+	 *	Ϊգ_countη佫˳ʹеĽڵۡ
+	 */
+	void reserve(std::size_t _count) {
+		if (_count)
+			_push_block(_count);
+	}
+
+	/*
+	 *	ӿڣsplice(_avl_node_pool&)
+	 *	ӹһڵصȫڴнڵۣʹӹ߱Ϊճء
+	 *	ӹʹõĽڵӴɱڵظͷš
+	 */
+	void splice(_avl_node_pool& _other) {
+		if (!_other._blocks)
+			return;
+		_other._retire_current();
+		auto _last = _other._blocks;
+		while (_last->next)
+			_last = _last->next;
+		// ӹܵڴ鶼Ѿþ˽ǽڵǰڴ֮
+		if (_blocks) {
+			_last->next = _blocks->next;
+			_blocks->next = _other._blocks;
+		}
+		else
+			_blocks = _other._blocks;
+		auto _tail = _other._free;
+		if (_tail) {
+			while (_tail->next)
+				_tail = _tail->next;
+			_tail->next = _free;
+			_free = _other._free;
+		}
+		_capacity += _other._capacity;
+		_other._blocks = nullptr;
+		_other._free = nullptr;
+		_other._capacity = 0;
+	}
+
+	/*
+	 *	ӿڣrelease()
+	 *	ڴ黹ϵͳ߱뱣֤еĽڵ㶼
+	 */
+	void release() {
+		while (_blocks) {
+			auto _next = _blocks->next;
+			::operator delete(_blocks);
+			_blocks = _next;
+		}
+		_free = nullptr;
+		_capacity = 0;
+	}
+
+	void swap(_avl_node_pool& _other) noexcept {
+		std::swap(_blocks, _other._blocks);
+		std::swap(_free, _other._free);
+		std::swap(_capacity, _other._capacity);
+	}
+
+	std::size_t capacity() const {
+		return _capacity;
+	}
+
+	/*
+	 *	ӿڣowns(const void*)
+	 *	ж_pǷλڱڵصĳڴУʱڴĸȡ
+	 */
+	bool owns(const void* _p) const {
+		auto _a = reinterpret_cast<std::uintptr_t>(_p);
+		for (auto _b = _blocks; _b; _b = _b->next) {
+			auto _first = reinterpret_cast<std::uintptr_t>(_slots_of(_b));
+			if (_a >= _first && _a < _first + _b->capacity * sizeof(_slot))
+				return true;
+		}
+		return false;
+	}
+
+	// ڵ۵ĵַ֮
+	static constexpr std::size_t slot_size() {
+		return sizeof(_slot);
+	}
+};
+
+/*
+ * enum avl_reclaim_modeclear()ʱͷŽڵķʽ
+ * avl_reclaim_immediateڵ߳ͷţĬϣ
+ * avl_reclaim_backgroundO(1)Ĵժɺ̨߳ͷš
+ * avl_reclaim_incrementalO(1)Ĵժ
+ * ֮reclaim(std::size_t)put()/remove()ͷš
+ */
+enum avl_reclaim_mode {
+	avl_reclaim_immediate,
+	avl_reclaim_background,
+	avl_reclaim_incremental
+};
+
+/*
+ * class _avl_reclaim_job̨Ļࡣ
+ */
+class _avl_reclaim_job {
+public:
+	virtual ~_avl_reclaim_job() = default;
+	virtual void run() = 0;
+};
+
+/*
+ * class _avl_reclaimerΨһĺ̨̡߳
+ * ߳ڵһύʱھ̬ʱʣ˳
+ * ߳˳Ժ󣨻޷߳ʱύڵֱִ߳С
+ */
+class _avl_reclaimer {
+private:
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::condition_variable _idle;
+	std::deque<std::unique_ptr<_avl_reclaim_job>> _jobs;
+	bool _stop = false;
+	bool _busy = false;
+	std::thread _worker;
+
+	// ߳ǷѾ˳ʹƽ֤ͣھ̬֮Կɶȡ
+	static bool& _shut_down() {
+		static bool _flag = false;
+		return _flag;
+	}
+
+	static _avl_reclaimer& _instance() {
+		static _avl_reclaimer _reclaimer;
+		return _reclaimer;
+	}
+
+	_avl_reclaimer() {
+		try {
+			_worker = std::thread([this]() { _loop(); });
+		}
+		catch (...) {
+			_stop = true;
+		}
+	}
+
+	~_avl_reclaimer() {
+		{
+			std::lock_guard<std::mutex> _lock(_mutex);
+			_stop = true;
+		}
+		_cv.notify_all();
+		if (_worker.joinable())
+			_worker.join();
+		_shut_down() = true;
+	}
+
+	void _loop() {
+		std::unique_lock<std::mutex> _lock(_mutex);
+		for (;;) {
+			_cv.wait(_lock, [this]() { return _stop || !_jobs.empty(); });
+			if (_jobs.empty())
+				return;
+			auto _job = std::move(_jobs.front());
+			_jobs.pop_front();
+			_busy = true;
+			_lock.unlock();
+			_job->run();
+			_job.reset();
+			_lock.lock();
+			_busy = false;
+			if (_jobs.empty())
+				_idle.notify_all();
+		}
+	}
+
+public:
+	/*
+	 *	ӿڣsubmit
+	 *	ύһ
+	 */
+	static void submit(std::unique_ptr<_avl_reclaim_job> _job) {
+		if (!_shut_down()) {
+			auto& _r = _instance();
+			std::unique_lock<std::mutex> _lock(_r._mutex);
+			if (!_r._stop) {
+				_r._jobs.push_back(std::move(_job));
+				_lock.unlock();
+				_r._cv.notify_one();
+				return;
+			}
+		}
+		_job->run();
+	}
+
+	/*
+	 *	ӿڣdrain
+	 *	ֱύĻִϡ
+	 */
+	static void drain() {
+		if (_shut_down())
+			return;
+		auto& _r = _instance();
+		std::unique_lock<std::mutex> _lock(_r._mutex);
+		_r._idle.wait(_lock, [&_r]() { return _r._stop || (_r._jobs.empty() && !_r._busy); });
+	}
+};
+
+/*
+ *	avl_reclaim_drain()
+ *	ȴ̨߳ͷѽĽڵ㡣
+ *	ڲڴռû˳ǰȷ״̬
+ */
+inline void avl_reclaim_drain() {
+	_avl_reclaimer::drain();
+}
+
+/*
+ * class template _avl_hash_traitsжܷΪavl<T, C, S, B>ɢ
+ * Ҫstd::hash<T>ãұȽΪĬϱȽ
+ * ʱȡֵɢֵͬԶȽΪɢֵֵͬȡ˲֧֡
+ * hashɢֵ֧ʱʵstd::hash<T>
+ */
+template <typename T, typename = void>
+struct _avl_hashable : std::false_type {};
+
+template <typename T>
+struct _avl_hashable<T, decltype(void(std::hash<T>()(std::declval<const T&>())))> : std::true_type {};
+
+template <typename T, typename C, bool = _avl_hashable<T>::value && _avl_plain_less<C, T>::value>
+struct _avl_hash_traits {
+	static constexpr bool enabled = false;
+	static std::size_t hash(const T&) {
+		return 0;
+	}
+};
+
+template <typename T, typename C>
+struct _avl_hash_traits<T, C, true> {
+	static constexpr bool enabled = true;
+	static std::size_t hash(const T& _value) {
+		return std::hash<T>()(_value);
+	}
+};
+
+/*
+ * class template _avl_hash_indexɢֵڵĿѰַɢб
+ * ̽飬ÿ۴Žڵָɢֵɢֵͬʱʽڵ㡣
+ * ۵±ɢֵԻƽָȡλõʹstd::hashǺȺҲܷɢ
+ * ɾʱļ¼ǰƶвĹ
+ * ĴСΪ2ݣԪװ֮ʱһ
+ */
+template <typename N>
+class _avl_hash_index {
+private:
+	struct _slot {
+		N* node;
+		std::size_t hash;
+	};
+
+	// Ϊʱۣ_shiftΪ64
+	std::vector<_slot> _slots;
+	std::size_t _count = 0;
+	unsigned _shift = 64;
+	double _max_load;
+
+	std::size_t _home(std::size_t _hash) const {
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(_hash) * 0x9E3779B97F4A7C15ull) >> _shift);
+	}
+
+	std::size_t _mask() const {
+		return _slots.size() - 1;
+	}
+
+	// ڱзһ¼֤߱пղۡ
+	void _place(N* _n, std::size_t _hash) {
+		std::size_t _i = _home(_hash);
+		while (_slots[_i].node)
+			_i = (_i + 1) & _mask();
+		_slots[_i] = _slot{ _n, _hash };
+	}
+
+	// 2^_bitsۣ·м¼
+	void _resize(unsigned _bits) {
+		std::vector<_slot> _old(std::size_t(1) << _bits, _slot{ nullptr, 0 });
+		_old.swap(_slots);
+		_shift = 64 - _bits;
+		for (auto& _s : _old)
+			if (_s.node)
+				_place(_s.node, _s.hash);
+	}
+
+	// _n¼λ
+	unsigned _bits_for(std::size_t _n) const {
+		unsigned _bits = 3;
+		while (static_cast<double>(std::size_t(1) << _bits) * _max_load < static_cast<double>(_n))
+			_bits++;
+		return _bits;
+	}
+
+public:
+	/*
+	 *	ӿڣ
+	 *	_loadװʣȡֵ(0, 0.9]װԽͣ̽Խ̣ռõڴԽࣺ
+	 *	ÿԪԼռsizeof(void*) + sizeof(std::size_t)װʵֽ
+	 */
+	explicit _avl_hash_index(double _load) : _max_load(_load) {}
+
+	double max_load() const {
+		return _max_load;
+	}
+
+	std::size_t memory() const {
+		return _slots.size() * sizeof(_slot);
+	}
+
+	// Ԥ_n¼Ŀռ䡣
+	void reserve(std::size_t _n) {
+		unsigned _bits = _bits_for(_n);
+		if (_bits > 64 - _shift)
+			_resize(_bits);
+	}
+
+	/*
+	 *	ӿڣfind
+	 *	ɢֵΪ_hash_eqĽڵ㣬Ҳʱؿָ롣
+	 */
+	template <typename E>
+	N* find(std::size_t _hash, E _eq) const {
+		if (!_count)
+			return nullptr;
+		for (std::size_t _i = _home(_hash); _slots[_i].node; _i = (_i + 1) & _mask())
+			if (_slots[_i].hash == _hash && _eq(_slots[_i].node))
+				return _slots[_i].node;
+		return nullptr;
+	}
+
+	/*
+	 *	ӿڣinsert
+	 *	һڵ㣬֤߱ûСȡĽڵ㡣
+	 *	ʱ׳std::bad_allocʱֲ䡣
+	 */
+	void insert(N* _n, std::size_t _hash) {
+		if (_slots.empty())
+			_resize(_bits_for(1));
+		else if (static_cast<double>(_count + 1) > static_cast<double>(_slots.size()) * _max_load)
+			_resize(64 - _shift + 1);
+		_place(_n, _hash);
+		_count++;
+	}
+
+	/*
+	 *	ӿڣerase
+	 *	ɾڵ_nļ¼Ȼͬһ̽ļ¼ǰƣճĲۡ
+	 */
+	void erase(N* _n, std::size_t _hash) {
+		if (!_count)
+			return;
+		std::size_t _i = _home(_hash);
+		while (_slots[_i].node != _n) {
+			if (!_slots[_i].node)
+				return;
+			_i = (_i + 1) & _mask();
+		}
+		for (std::size_t _j = (_i + 1) & _mask(); _slots[_j].node; _j = (_j + 1) & _mask()) {
+			std::size_t _k = _home(_slots[_j].hash);
+			bool _stays = _i <= _j ? (_i < _k && _k <= _j) : (_i < _k || _k <= _j);
+			if (!_stays) {
+				_slots[_i] = _slots[_j];
+				_i = _j;
+			}
+		}
+		_slots[_i].node = nullptr;
+		_count--;
+	}
+
+	// м¼ͷвۡ
+	void clear() {
+		std::vector<_slot>().swap(_slots);
+		_count = 0;
+		_shift = 64;
+	}
+};
+
+/*
+ * class _avl_bloom_filterֿĲ¡ɢֵжԪǷһڡ
+ * ÿԪֻһ64ֽڣ512λĿУڿkλһβѯһλȱʧ
+ * ڵkλȡɢֵΪӵͬеĸ9λֻ512λ
+ * ɢֵ˫ɢУܵλ̫٣Ըֵ
+ * ֻɾԪʱλֻһιڡ
+ * ԪسڵԪعʱʹ߰ǰԪؽ
+ */
+class _avl_bloom_filter {
+private:
+	static constexpr std::size_t _block_words = 8;
+
+	std::vector<std::uint64_t> _bits;
+	std::size_t _blocks = 0;
+	unsigned _k;
+	// ÿԪռõλĿʾ
+	double _bits_per_item;
+	double _target;
+	// ڴޣֽڣΪ0ʱޡ
+	std::size_t _budget;
+	// ԪزֵʱʲĿֵڴԼʱ
+	std::size_t _capacity = 0;
+	// ϴؽɾԪ
+	std::size_t _added = 0;
+	std::size_t _stale = 0;
+
+	// ɢֵĻϺsplitmix64սᲽ裩std::hashΪȺʱҲܵõȵλ
+	static std::uint64_t _mix(std::size_t _hash) {
+		std::uint64_t _x = static_cast<std::uint64_t>(_hash);
+		_x = (_x ^ (_x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		_x = (_x ^ (_x >> 27)) * 0x94D049BB133111EBull;
+		return _x ^ (_x >> 31);
+	}
+
+	// ƽͬУؿڵһλã0511
+	static unsigned _next_bit(std::uint64_t& _state) {
+		_state = _state * 0x5851F42D4C957F2Dull + 0x14057B7EF767814Full;
+		return static_cast<unsigned>(_state >> 55);
+	}
+
+	/*
+	 *	_blocked_fpr
+	 *	ÿƽ_loadԪʱʡеԪƷӲɷֲ
+	 *	Ԫؽ϶Ŀʸߵö࣬˷ֿĹȲֿʱҪλ
+	 */
+	static double _blocked_fpr(double _load, unsigned _k) {
+		double _sum = 0;
+		double _p = std::exp(-_load);
+		double _limit = _load + 12 * std::sqrt(_load) + 12;
+		for (double _i = 0; _i <= _limit; _i++) {
+			_sum += _p * std::pow(1 - std::exp(-static_cast<double>(_k) * _i / 512), static_cast<double>(_k));
+			_p *= _load / (_i + 1);
+		}
+		return _sum;
+	}
+
+	// ɢֵĿеһֵ±ꡣ
+	std::size_t _block_of(std::uint64_t _h) const {
+		return static_cast<std::size_t>(((_h >> 32) * _blocks) >> 32) * _block_words;
+	}
+
+public:
+	/*
+	 *	ӿڣ
+	 *	_fprĿʣȡֵ(0, 0.5]ÿԪռ-ln(_fpr) / (ln 2)^2λ
+	 *	1%ԼΪ9.6λ0.1%ԼΪ14.4λӣֱֿʲĿֵ
+	 *	_budgetڴޣֽڣΪ0ʱޣﵽ޺Ԫص
+	 */
+	_avl_bloom_filter(double _fpr, std::size_t _max_bytes) : _target(_fpr), _budget(_max_bytes) {
+		const double _ln2 = std::log(2.0);
+		_bits_per_item = -std::log(_fpr) / (_ln2 * _ln2);
+		double _k_best = std::floor(_bits_per_item * _ln2 + 0.5);
+		_k = _k_best < 1 ? 1 : _k_best > 16 ? 16 : static_cast<unsigned>(_k_best);
+		while (_bits_per_item < 64 && _blocked_fpr(512 / _bits_per_item, _k) > _fpr)
+			_bits_per_item *= 1.05;
+	}
+
+	/*
+	 *	ӿڣreset(std::size_t)
+	 *	չ_expectedԪأһȷС
+	 *	ڴʧʱ׳std::bad_allocʱֲ䡣
+	 */
+	void reset(std::size_t _expected) {
+		std::size_t _cap = _expected + _expected / 2;
+		if (_cap < 1024)
+			_cap = 1024;
+		std::size_t _n = static_cast<std::size_t>(std::ceil(static_cast<double>(_cap) * _bits_per_item / 512));
+		if (_budget && _n > _budget / (_block_words * sizeof(std::uint64_t)))
+			_n = _budget / (_block_words * sizeof(std::uint64_t));
+		if (!_n)
+			_n = 1;
+		std::vector<std::uint64_t> _fresh(_n * _block_words, 0);
+		_bits.swap(_fresh);
+		_blocks = _n;
+		_capacity = _cap;
+		_added = _stale = 0;
+	}
+
+	// λѷڴ档
+	void clear() {
+		std::fill(_bits.begin(), _bits.end(), 0);
+		_added = _stale = 0;
+	}
+
+	void add(std::size_t _hash) {
+		if (!_blocks)
+			return;
+		std::uint64_t _h = _mix(_hash);
+		auto _b = _bits.data() + _block_of(_h);
+		for (unsigned _i = 0; _i < _k; _i++) {
+			unsigned _pos = _next_bit(_h);
+			_b[_pos >> 6] |= std::uint64_t(1) << (_pos & 63);
+		}
+		_added++;
+	}
+
+	// ԪһʱfalseδڴʱǷtrue
+	bool may_contain(std::size_t _hash) const {
+		if (!_blocks)
+			return true;
+		std::uint64_t _h = _mix(_hash);
+		auto _b = _bits.data() + _block_of(_h);
+		for (unsigned _i = 0; _i < _k; _i++) {
+			unsigned _pos = _next_bit(_h);
+			if (!(_b[_pos >> 6] & (std::uint64_t(1) << (_pos & 63))))
+				return false;
+		}
+		return true;
+	}
+
+	void forget() {
+		_stale++;
+	}
+
+	/*
+	 *	ӿڣneeds_rebuild(std::size_t)
+	 *	ԪسڵԪسһ룬
+	 *	ԪѲİ˷֮һʱӦǰ_liveԪؽ
+	 */
+	bool needs_rebuild(std::size_t _live) const {
+		return !_blocks || _added > _capacity || _stale > _capacity / 2 || (_capacity > 8192 && _live < _capacity / 8);
+	}
+
+	double target() const {
+		return _target;
+	}
+
+	std::size_t budget() const {
+		return _budget;
+	}
+
+	std::size_t capacity() const {
+		return _capacity;
+	}
+
+	std::size_t stale() const {
+		return _stale;
+	}
+
+	std::size_t memory() const {
+		return _bits.size() * sizeof(std::uint64_t);
+	}
+
+	// ϴؽԪƵǰʡ
+	double estimated_fpr() const {
+		if (!_blocks || !_added)
+			return 0;
+		return _blocked_fpr(static_cast<double>(_added) / static_cast<double>(_blocks), _k);
+	}
+};
+
+/*
+ * struct avl_filter_statsԱ״̬avl<T, C, S, B>::membership_filter()ɡ
+ * Ա˵
+ * target_fpr趨ĿʣΪ0ʱʾδù
+ * estimated_fprǰԪƵʡ
+ * memoryռõڴ棨ֽڣ
+ * memory_budget趨ڴޣֽڣΪ0ʱޡ
+ * capacityһ֮ǰԼԪ
+ * staleɾλڹеԪһؽʱ
+ */
+struct avl_filter_stats {
+	double target_fpr = 0;
+	double estimated_fpr = 0;
+	std::size_t memory = 0;
+	std::size_t memory_budget = 0;
+	std::size_t capacity = 0;
+	std::size_t stale = 0;
+};
+
+/*
+ * enum avl_layoutrelayout()Ųڵ˳
+ * avl_layout_in_orderŲ˳ѯʱηڵڴ档
+ * avl_layout_vebvan Emde Boas˳Ųмĸ߶п
+ * Ųϰ벿֣Ųĸ־ݹŲ
+ * ԸµĲСĻ϶ֻO(log_B n)ȱʧ
+ */
+enum avl_layout {
+	avl_layout_in_order,
+	avl_layout_veb
+};
+
+/*
+ * struct avl_localityڵڴеľֲԣavl<T, C, S, B>::locality()ɡ
+ * Ա˵
+ * sequentialڵĽڵУλڽڵеıӳľֲԡ
+ * descentӽڵУλͬһ4KiBڴҳеıӳҵľֲԡ
+ * ߵȡֵΧΪ[0, 1]ԽԽãɾ֮ͨӽ0
+ */
+struct avl_locality {
+	double sequential = 1;
+	double descent = 1;
+};
+
+/*
+ * enum avl_evictionģʽѡ̭ԪصĲԣavl<T, C, S, B>::set_capacity
+ * avl_evict_smallesṱСԪأбɸԪء
+ * avl_evict_largesṱԪأбСɸԪء
+ * avl_evict_lruƵʹãCLOCK㷨ÿڵһλ
+ * ʱλ̭ʱϴͣµλðɨ裬;ķλ
+ * ̭ĵһλΪ0Ԫء
+ */
+enum avl_eviction {
+	avl_evict_smallest,
+	avl_evict_largest,
+	avl_evict_lru
+};
+
+/*
+ * struct avl_cache_statsģʽµļavl<T, C, S, B>::cache_stats()ɡ
+ * Ա˵
+ * hitsfindlocateҵԪصĴ
+ * missesfindlocateδҵԪصĴ
+ * evictions򳬳̭Ԫظ
+ */
+struct avl_cache_stats {
+	std::uint64_t hits = 0;
+	std::uint64_t misses = 0;
+	std::uint64_t evictions = 0;
+};
+
+/*
+ * struct template avl_change޸־еһ޸ġ
+ * Ա˵
+ * valueɾֵ
+ * eraseΪtrueʱʾɾʾ롣
+ */
+template <typename T>
+struct avl_change {
+	T value;
+	bool erase;
+};
+
+/*
+ * struct template avl_deltaavl<T, C, S, B>::delta_sinceɵ
+ * ɽһapply_deltaʹ׷ϡ
+ * Ա˵
+ * resetΪtrueʱʾӦǰգڼ䷢clear()
+ * changesȽе޸ģÿֵһֻһ޸ġ
+ */
+template <typename T>
+struct avl_delta {
+	bool reset = false;
+	std::vector<avl_change<T>> changes;
+};
+
+/*
+ * function template _avl_merge_changesһ鰴˳е޸İȽȶ
+ * ÿֵֻһõɽapply_deltachanges
+ * delta_sincedurable_avl.hе־طŹá
+ */
+template <typename T, typename C>
+void _avl_merge_changes(std::vector<avl_change<T>>& _changes, const C& _comp) {
+	auto _less = [&_comp](const avl_change<T>& _lhs, const avl_change<T>& _rhs) {
+		return _comp(_lhs.value, _rhs.value);
+	};
+	std::stable_sort(_changes.begin(), _changes.end(), _less);
+	std::size_t _w = 0;
+	for (std::size_t _i = 0; _i < _changes.size(); _i++) {
+		if (_w && !_less(_changes[_w - 1], _changes[_i]))
+			_changes[_w - 1] = std::move(_changes[_i]);
+		else if (_w++ != _i)
+			_changes[_w - 1] = std::move(_changes[_i]);
+	}
+	_changes.erase(_changes.begin() + static_cast<std::ptrdiff_t>(_w), _changes.end());
+}
+
+/*
+ * ƽԣΪavlģBɾ֮λָƽ⡣
+ * Ա˵
+ * rankedΪtrueʱڵfactorֶδ洢ȣrankƽӣ
+ * ҶڵΪ0Ϊ-1ӽڵ֮ΪȲ
+ * rebalance_on_removeɾǷṹ
+ */
+
+/*
+ * struct avl_strict_balanceĬϵƽԣAVL
+ * ĸ߶1߲1.44log(n)죬
+ * ɾʱһ·תڵ㡣
+ */
+struct avl_strict_balance {
+	static constexpr bool ranked = false;
+	static constexpr bool rebalance_on_remove = true;
+};
+
+/*
+ * struct avl_weak_balanceAVLWAVLһֻȵƽ
+ * ÿڵȲΪ12ҶڵΪ0
+ * ֻвʱAVLȫͬɾʱתΣһ˫ת
+ * ߲min(1.44log(m), 2log(n))mΪĴ
+ */
+struct avl_weak_balance {
+	static constexpr bool ranked = true;
+	static constexpr bool rebalance_on_remove = true;
+};
+
+/*
+ * struct avl_relaxed_balanceɾʱṹɳƽ⡣
+ * avl_weak_balanceͬɾֻժ½ڵ㣬Ȳ˿ܴ2
+ * ߲1.44log(m)Ϊʹ䱣O(log n)
+ * ɾۼƳԪظʱO(n)Ĵؽ̯ÿɾΪO(1)
+ * ʺд١ɾƵĳϡ
+ */
+struct avl_relaxed_balance {
+	static constexpr bool ranked = true;
+	static constexpr bool rebalance_on_remove = false;
+};
+
+// ͵ǰ
+template <typename T, typename C, typename S, typename B>
+class _avl_iterator;
+
+// бʵ֣avl_parallel.hǰ
+template <typename T, typename C, typename S, typename B>
+struct _avl_parallel;
+
+/*
+ * class template avlAVLƽ
+ * ģ˵
+ * TͣҪ˲֧operator<Ĭ
+ * ԶȽͬʱп
+ * CȽͣĬΪstd::less<T>
+ * ñȽʹToperator<ɱȽϡ
+ * SͳƲԣĬΪavl_no_statsκο
+ * ʹavl_counting_statsռȽϡתݡڲݣ
+ * ͨstats()
+ * BƽԣĬΪavl_strict_balance
+ * avl_weak_balanceavl_relaxed_balanceɹѡ
+ */
+template <typename T, typename C = std::less<T>, typename S = avl_no_stats, typename B = avl_strict_balance>
+class avl final : public S {
+	// Ե͵Ԫ
+	friend class _avl_iterator<T, C, S, B>;
+	// бҪֱӷʽڵ㣬Ϊ
+	friend struct _avl_parallel<T, C, S, B>;
+	// ˽ʵֲ֡
+private:
+	/*
+	 * ݽṹ_node*(typename avl<T, C, S, B>::_node*)
+	 * ʹʾʾĶеÿڵ㡣
+	 * Ա˵
+	 * valueΪT洢ڵֵֻupdatemodifyڱ˳ǰ¸д
+	 * leftChildrightChildΪ_node*ֱ洢Ϣ
+	 * parentΪ_node*洢ڵϢ
+	 * factorΪstd::ptrdiff_t洢ڵƽӣȵƽ´洢ڵȣ
+	 * deadΪboolɾģʽ±ǽڵѱɾĹ
+	 * referencedΪboolģʽµķλʱλ̭ʱɨ
+	 */
+	struct _node : _avl_key_traits<T, C>::node_base {
+		T value;
+		_node* leftChild = nullptr;
+		_node* rightChild = nullptr;
+		_node* parent = nullptr;
+		std::ptrdiff_t factor = 0;
+		bool dead = false;
+		mutable bool referenced = false;
+		// ڹTĲЩڳʼvalueֶΡ
+		template <typename... A>
+		explicit _node(A&&... _args) : value(std::forward<A>(_args)...) {
+			_avl_key_traits<T, C>::assign(*this, value);
+		}
+		~_node() = default;
+	};
+	// ˽ֶΣ_rootΪ_node*洢AVLĸڵ㡣
+	_node* _root;
+	// ˽ֶΣ_sizeΪstd::size_t洢AVLĴСĹ
+	std::size_t _size;
+	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
+	C _comparator;
+	// ˽ֶΣ_poolΪ_avl_node_pool<_node>нڵӴ˽ڵз䡣
+	_avl_node_pool<_node> _pool;
+
+	/*
+	 * ݽṹ_grave
+	 * ģʽ±ժ¡δͷϵһ
+	 * Ա˵
+	 * cursorһμͷŵλãΪʱʾнڵ
+	 * poolĽڵأڵȫͳһͷš
+	 * nextһôյ
+	 */
+	struct _grave {
+		_node* cursor;
+		_avl_node_pool<_node> pool;
+		_grave* next;
+	};
+
+	/*
+	 * ݽṹ_reclaim_task
+	 * ̵̨߳ȻͷĽڵء
+	 */
+	struct _reclaim_task : _avl_reclaim_job {
+		_node* root;
+		_avl_node_pool<_node> pool;
+		explicit _reclaim_task(_node* _r) : root(_r) {}
+		void run() override {
+			std::size_t _budget = static_cast<std::size_t>(-1);
+			_destroy_nodes(root, _budget);
+			pool.release();
+		}
+	};
+
+	// ˽ֶΣ_reclaimΪavl_reclaim_modeclear()ʱͷŽڵķʽ
+	avl_reclaim_mode _reclaim = avl_reclaim_immediate;
+	// ˽ֶΣ_gravesģʽµȴͷŵ
+	_grave* _graves = nullptr;
+	// ģʽ£ÿput()remove()˳Ľڵ
+	static constexpr std::size_t _reclaim_slice = 64;
+
+	// ˽ֶΣ_deadΪstd::size_tĹڵĸ
+	std::size_t _dead = 0;
+	// ˽ֶΣ_lazyɾģʽ´ѹĹΪ0ʱʾʹöɾ
+	double _lazy = 0;
+	// ˽ֶΣ_debtɳƽ£ϴؽδṹɾ
+	std::size_t _debt = 0;
+	// ˽ֶΣ_versionİ汾ţÿʵ޸Ԫʱ1ֻ
+	std::uint64_t _version = 0;
+	// ˽ֶΣ_journalingǷ޸־
+	bool _journaling = false;
+	// ˽ֶΣ_journal޸־i¼ʹ汾Ŵ_journal_base + iΪ_journal_base + i + 1
+	std::vector<avl_change<T>> _journal;
+	std::uint64_t _journal_base = 0;
+	// ˽ֶΣ_journal_floorԴӴ˰汾֮İ汾
+	// _journal_floor_journal_base֮İ汾֮clear()
+	std::uint64_t _journal_floor = 0;
+	// ˽ֶΣ_indexѡɢֵӳ䵽ڵ㣨ĹΪʱʾδá
+	std::unique_ptr<_avl_hash_index<_node>> _index;
+	// ˽ֶΣ_filterѡĳԱԪأĹɢֵΪʱʾδá
+	std::unique_ptr<_avl_bloom_filter> _filter;
+	// ˽ֶΣ_leftmost_rightmostĵһһڵ㣨ĹΪʱΪա
+	_node* _leftmost = nullptr;
+	_node* _rightmost = nullptr;
+	// ˽ֶΣ_defragging_defrag_cursordefragment()Ƿڽһ
+	// ԼѰƵһֵΪʱʾδκνڵ㡣
+	bool _defragging = false;
+	std::unique_ptr<T> _defrag_cursor;
+	// ˽ֶΣ_defrag_pool_defrag_liveרõĽڵأƵĽڵ˳䣬
+	// put()ȲʹԼδͷŵĽڵʱȡ_pool
+	_avl_node_pool<_node> _defrag_pool;
+	std::size_t _defrag_live = 0;
+	// ˽ֶΣ_bound_eviction޼̭ԣ_boundΪ0ʱʾ
+	std::size_t _bound = 0;
+	avl_eviction _eviction = avl_evict_lru;
+	// ˽ֶΣ_handCLOCK̭´οʼɨĽڵ㣬ΪʱĽڵ㿪ʼ
+	_node* _hand = nullptr;
+	// ˽ֶΣ_hits_misses_evictionsģʽµļstruct avl_cache_stats
+	mutable std::uint64_t _hits = 0;
+	mutable std::uint64_t _misses = 0;
+	std::uint64_t _evictions = 0;
+	// CLOCK̭ʱķλֱ̭֮һԪأ֤ÿ̭Ĵн硣
+	static constexpr std::size_t _clock_scan = 64;
+
+	// ʱݼķʽͰֵݣͰôݡ
+	using _key_type = typename std::conditional<_avl_fast_key<T, C>::value, T, const T&>::type;
+
+	/*
+	 * _compare
+	 * жԪصԴС֤ȽϲΡ
+	 * ҪȽʵ֡
+	 * 
+	 * _lhsȽϵԪء
+	 * _rhsȽϵԪء
+	 * ֵint
+	 * ֵΪ-1_lhsСڡ_rhs
+	 * ֵΪ0_lhsڡ_rhs
+	 * ֵΪ1_lhsڡ_rhs
+	 */
+	int _compare(_key_type _lhs, _key_type _rhs) const {
+		this->_stat_compare();
+		return _avl_key_traits<T, C>::compare(_comparator, _lhs, _rhs);
+	}
+
+	/*
+	 * _compareҰ汾
+	 * һβнҵļڵȽϡ
+	 * _probeл˼ԤϢڵл˽ڵֵԤϢ
+	 * _avl_key_traits<T, C>ԼٷʽڵֵĴ
+	 */
+	using _probe = typename _avl_key_traits<T, C>::probe;
+
+	int _compare(_probe& _p, const _node* _n) const {
+		this->_stat_compare();
+		return _avl_key_traits<T, C>::compare(_comparator, _p, *_n, _n->value);
+	}
+
+	/*
+	 *	avl(_node*, std::size_t, C)
+	 *	˽йṩԱʹá
+	 *	ڶAVLĸá
+	 */
+	avl(_node* _root_node, std::size_t _sz, C _comp) : _root(_root_node), _size(_sz),
+
+		_comparator(_comp) {}
+
+	/*
+	 *	_new_node_delete_node
+	 *	нڵķͷžɣ
+	 *	ڵĴ洢Խڵ_poolͬʱͳƲԼ¼
+	 *	defragment()ʱֵ½ڵķ_defrag_pool
+	 *	Ȿֽʱ_poolнڵ㣻ΪƶԪʱ׳쳣_poolС
+	 */
+	template <typename... A>
+	_node* _new_node(A&&... _args) {
+		this->_stat_alloc(1);
+		auto _n = _construct_node(_pool, std::forward<A>(_args)...);
+		if (_defragging && _defrag_cursor && _compare(_n->value, *_defrag_cursor) <= 0) {
+			try {
+				auto _m = _construct_node(_defrag_pool, std::move_if_noexcept(_n->value));
+				_n->~_node();
+				_pool.deallocate(_n);
+				_n = _m;
+				_defrag_live++;
+			}
+			catch (...) {
+			}
+		}
+		return _n;
+	}
+
+	void _delete_node(_node* _n) {
+		if (_n == _hand)
+			_hand = nullptr;
+		if (_index)
+			_index->erase(_n, _avl_hash_traits<T, C>::hash(_n->value));
+		this->_stat_free(1);
+		_n->~_node();
+		if (_defragging && _defrag_pool.owns(_n)) {
+			_defrag_live--;
+			_defrag_pool.deallocate(_n);
+		}
+		else
+			_pool.deallocate(_n);
+	}
+
+	/*
+	 *	_defrag_abort
+	 *	ڽеһרõĽڵز_pool˺нڵ_pool
+	 */
+	void _defrag_abort() noexcept {
+		_pool.splice(_defrag_pool);
+		_defragging = false;
+		_defrag_cursor.reset();
+		_defrag_live = 0;
+	}
+
+	/*
+	 *	_touch
+	 *	ģʽ¼¼һβҵĽʱλڵķλ_hits_misses
+	 *	ʱʲôҲ˲ֻҲд
+	 */
+	void _touch(const _node* _n) const {
+		if (!_bound)
+			return;
+		if (_n && !_n->dead) {
+			_n->referenced = true;
+			_hits++;
+		}
+		else
+			_misses++;
+	}
+
+	/*
+	 *	_construct_node
+	 *	ָĽڵйһڵ㡣TĹ׳쳣黹ڵۡ
+	 */
+	template <typename... A>
+	static _node* _construct_node(_avl_node_pool<_node>& _from, A&&... _args) {
+		void* _p = _from.allocate();
+		try {
+			return ::new (_p) _node(std::forward<A>(_args)...);
+		}
+		catch (...) {
+			_from.deallocate(_p);
+			throw;
+		}
+	}
+
+	/*
+	 *	_copy_settings_copy_accelerators
+	 *	ƶ븳ֵԼclone()ã
+	 *	ʹĸԱһ£շʽɾֵ̭Ԫһͬתƣ
+	 *	Ĺǳ˶ɾС
+	 *	_copy_acceleratorsԪظ֮_srcûرɢԱ
+	 *	ƶʱڵһͬתƣá
+	 */
+	void _copy_settings(const avl& _src) {
+		_reclaim = _src._reclaim;
+		_lazy = _src._lazy;
+		_bound = _src._bound;
+		_eviction = _src._eviction;
+	}
+
+	void _copy_accelerators(const avl& _src) {
+		set_hash_index(_src._index ? _src._index->max_load() : 0);
+		if (_src._filter)
+			set_membership_filter(_src._filter->target(), _src._filter->budget());
+		else
+			set_membership_filter(0);
+	}
+
+	// ¸䶨֮ע͡
+	_node* _insert_node(_node*, _key_type);
+	_node* _find_position(_node*, _key_type, _node*&, bool&) const;
+	_node* _hint_position(_node*, const T&, _node*&, bool&) const;
+	_node* _finger_node(const _node*, const T&, bool&) const;
+	void _attach_node(_node*, bool, _node*);
+	void _retrace_insert(_node*);
+	void _rank_insert(_node*);
+	void _rank_remove(_node*, bool);
+	void _rebuild();
+	const _node* _find_node(const _node*, _key_type) const;
+	void _remove_node(_node*);
+	void _unlink_node(_node*);
+	static std::size_t _height(const _node*);
+	static std::ptrdiff_t _rank(const _node*);
+	_node* _join(_node*, std::size_t, _node*, _node*, std::size_t, std::size_t&);
+	_node* _join(_node*, std::size_t, _node*, std::size_t, std::size_t&);
+	void _split(_node*, std::size_t, const T&, _node*&, std::size_t&, _node*&, std::size_t&);
+	std::size_t _free_subtree(_node*);
+	static _node* _build_tree(_node* const*, std::size_t, std::size_t&);
+	static _node* _destroy_nodes(_node*, std::size_t&);
+	void _make_copy(avl&, std::size_t) const;
+	static _node* _copy_node(const _node*, _avl_node_pool<_node>&);
+	void _swap_node(_node*, _node*);
+	void _bury_node(_node*);
+	void _revive_node(_node*);
+	template <typename V>
+	_node* _update_node(_node*, V&&);
+	static const _node* _successor(const _node*);
+	static const _node* _predecessor(const _node*);
+	const _node* _first_node() const;
+	const _node* _last_node() const;
+	void _reset_extremes();
+	void _log(const T&, bool);
+	const _node* _lookup(const T&) const;
+	void _index_insert(_node*);
+	void _index_rebuild();
+	void _filter_rebuild();
+	void _filter_maintain();
+	bool _enforce_capacity(const _node*);
+	_node* _clock_victim(const _node*);
+	_node* _transplant(_node*);
+	static void _veb_order(_node*, std::size_t, std::vector<_node*>&);
+	static void _veb_bottom(_node*, std::size_t, std::size_t, std::vector<_node*>&);
+	void _log_reset();
+	void _journal_break();
+	_node* _check_tree(_node*);
+	_node* _ll_rotate(_node*);
+	_node* _rr_rotate(_node*);
+	_node* _lr_rotate(_node*);
+	_node* _rl_rotate(_node*);
+
+	/*
+	 *	_is_left_child
+	 *	жϼҳͺӵĹϵ
+	 *	
+	 *	_parentΪ_node*жϵĸڵ㡣
+	 *	_childΪ_node*жϵӽڵ㡣
+	 *	ֵboolָӽڵǸڵ
+	 *	ֵΪtrueӽڵǸڵ
+	 *	ֵΪfalseӽڵǸڵ
+	 *	ĵõ㱣֤ڵϵ
+	 *	ڵ㲻ϵݽṹѾ
+	 *	˵std::terminate()
+	 */
+	bool _is_left_child(_node* _parent, _node* _child) {
+		if (_parent->leftChild == _child)
+			return true;
+		else if (_parent->rightChild == _child)
+			return false;
+		else
+			std::terminate();
+		return false;
+	}
+
+public:
+	// Ӧͱ
+	// Ϊ_avl_iterator<T, C, S, B>̳std::iterator
+	// <std::bidirectional_iterator_tag, const T>
+	// Ϊconst_iteratorʹá
+	using size_type = std::size_t;
+	using iterator = _avl_iterator<T, C, S, B>;
+	using const_iterator = _avl_iterator<T, C, S, B>;
+	using reverse_iterator = std::reverse_iterator<_avl_iterator<T, C, S, B>>;
+	using const_reverse_iterator = std::reverse_iterator<_avl_iterator<T, C, S, B>>;
+
+	/*
+	 *	ӿڣ/ĬϹ
+	 *	ܣѡģ
+	 *	빹ĬϹһ
+	 *	ùί˽йɹ
+	 */
+	avl(C comp = C()) : avl(nullptr, 0, comp) {}
+
+	/*
+	 *	ӿڣ
+	 *	Ʊ_comparatorֶΣ
+	 *	ٵø_make_copy(avl&, std::size_t)ݵĸơ
+	 */
+	avl(const avl& src) : avl(nullptr, 0, src._comparator) {
+		_copy_settings(src);
+		src._make_copy(*this, 1);
+		_copy_accelerators(src);
+	}
+
+	/*
+	 *	ӿڣֵ
+	 *	ȵùӿclear()ڲݣ
+	 *	Ȼٴӱиã
+	 *	뿽ֻͬ޸־Ҫơ
+	 */
+	avl& operator=(const avl& src) {
+		if (this != &src) {
+			clear();
+			_comparator = src._comparator;
+			_copy_settings(src);
+			reset_cache_stats();
+			src._make_copy(*this, 1);
+			_copy_accelerators(src);
+			_journal_break();
+		}
+		return *this;
+	}
+
+	/*
+	 *	ӿڣƶ캯
+	 *	ƶ캯ӱƶȡݣڵأ
+	 *	ƶڿİȫ״̬С
+	 */
+	avl(avl&& src) noexcept : avl(src._root, src._size, src._comparator) {
+		_copy_settings(src);
+		_dead = src._dead;
+		_debt = src._debt;
+		_leftmost = src._leftmost;
+		_rightmost = src._rightmost;
+		_version = src._version;
+		_journaling = src._journaling;
+		_journal.swap(src._journal);
+		_journal_base = src._journal_base;
+		_journal_floor = src._journal_floor;
+		_index = std::move(src._index);
+		_filter = std::move(src._filter);
+		_hand = src._hand;
+		_hits = src._hits;
+		_misses = src._misses;
+		_evictions = src._evictions;
+		src._defrag_abort();
+		_pool.swap(src._pool);
+		src._root = nullptr;
+		src._size = 0;
+		src._dead = 0;
+		src._debt = 0;
+		src._leftmost = src._rightmost = nullptr;
+		src._hand = nullptr;
+		src._journal_break();
+	}
+
+	/*
+	 *	ӿڣƶֵ
+	 *	߼ƶ캯ƣ
+	 *	Ҫݣ޸־
+	 */
+	avl& operator=(avl&& src) noexcept {
+		if (this != &src) {
+			clear();
+			_copy_settings(src);
+			_hits = src._hits;
+			_misses = src._misses;
+			_evictions = src._evictions;
+			_root = src._root;
+			_size = src._size;
+			_dead = src._dead;
+			_debt = src._debt;
+			_leftmost = src._leftmost;
+			_rightmost = src._rightmost;
+			_hand = src._hand;
+			_index = std::move(src._index);
+			_filter = std::move(src._filter);
+			_comparator = src._comparator;
+			src._defrag_abort();
+			_pool.swap(src._pool);
+			src._root = nullptr;
+			src._size = 0;
+			src._dead = 0;
+			src._debt = 0;
+			src._leftmost = src._rightmost = nullptr;
+			src._hand = nullptr;
+			src._journal_break();
+			_journal_break();
+		}
+		return *this;
+	}
+
+	/*
+	 *	ӿڣclone(std::size_t)
+	 *	رAVLһݿ
+	 *	
+	 *	_threadsڸƵ߳ĬΪ1
+	 *	_threads1㹻ʱɲɵ̸߳ƣ
+	 *	µĸɶ̲߳иơ
+	 *	ֵavlAVLĿ
+	 */
+	avl clone(std::size_t _threads = 1) const {
+		avl _copy(nullptr, 0, _comparator);
+		_copy._copy_settings(*this);
+		_make_copy(_copy, _threads);
+		_copy._copy_accelerators(*this);
+		return _copy;
+	}
+
+	/*
+	 *	ӿڣ
+	 *	ڶʱͷݣ
+	 *	òͨùӿclear()ɡ
+	 */
+	~avl() {
+		// յģʽ£δͬһ𽻸̨̡߳
+		if (_reclaim != avl_reclaim_immediate) {
+			while (_graves) {
+				auto _g = _graves;
+				_graves = _g->next;
+				try {
+					std::unique_ptr<_reclaim_task> _task(new _reclaim_task(_g->cursor));
+					_task->pool.swap(_g->pool);
+					_avl_reclaimer::submit(std::move(_task));
+				}
+				catch (...) {
+					std::size_t _budget = static_cast<std::size_t>(-1);
+					_destroy_nodes(_g->cursor, _budget);
+				}
+				delete _g;
+			}
+			_reclaim = avl_reclaim_background;
+		}
+		clear();
+	}
+
+	/*
+	 *	ӿڣset_reclaim_mode(avl_reclaim_mode)reclaim_mode()
+	 *	ûѯclear()ʱͷŽڵķʽμavl_reclaim_mode
+	 */
+	void set_reclaim_mode(avl_reclaim_mode _mode) {
+		_reclaim = _mode;
+	}
+
+	avl_reclaim_mode reclaim_mode() const {
+		return _reclaim;
+	}
+
+	/*
+	 *	ӿڣreclaim(std::size_t)
+	 *	ģʽ£_budgetȴյĽڵ㣬
+	 *	ϵĽڵ漴ͷš
+	 *	
+	 *	_budgetĽڵ
+	 *	ֵboolָʾǷеȴյĽڵ㡣
+	 */
+	bool reclaim(std::size_t _budget) {
+		while (_graves) {
+			_graves->cursor = _destroy_nodes(_graves->cursor, _budget);
+			if (_graves->cursor)
+				break;
+			auto _next = _graves->next;
+			delete _graves;
+			_graves = _next;
+		}
+		return static_cast<bool>(_graves);
+	}
+
+	/*
+	 *	ӿڣset_lazy_remove(double)lazy_remove()tombstones()
+	 *	ûѯɾģʽɾģʽ£removeerase(const_iterator)
+	 *	ֻڵΪĹĽṹ۽Ϊһβң
+	 *	ĹputȡĹʱ临ԭеֵ
+	 *	Ĺռȫڵı_thresholdʱcompact()Ĺ
+	 *	
+	 *	_thresholdѹĹȡֵ(0, 1)Ϊ0ʱرնɾѹ
+	 */
+	void set_lazy_remove(double _threshold) {
+		_lazy = _threshold > 0 ? _threshold : 0;
+		if (!_lazy)
+			compact();
+	}
+
+	double lazy_remove() const {
+		return _lazy;
+	}
+
+	size_type tombstones() const {
+		return _dead;
+	}
+
+	/*
+	 *	ӿڣrebalance()
+	 *	O(n)Ĵ۽ؽΪȫƽͬʱĹ
+	 *	ɳƽԻɾۻһ̶ʱԶã
+	 *	ڴɾܼ֮֮ǰҲֶá
+	 */
+	void rebalance();
+
+	void compact();
+
+	/*
+	 *	ӿڣrelayout(avl_layout)defragment(size_type)locality()
+	 *	ɾ֮󣬽ڵɢڽڵصĸҵĻȱʧ֮ࡣ
+	 *	relayoutָ˳нڵ㣨ĹƵһµڴУ
+	 *	ͷԭȫڴ飬ĽṹԪز䣬ʱO(n)
+	 *	TĿ׳쳣ֲ䣨ǿ쳣ȫ֤
+	 *	defragmentrelayout(avl_layout_in_order)汾ʺڿʱã
+	 *	ÿεఴ_budgetڵ㣬ε֮޸
+	 *	ƵĽڵڱרõڴУ벻ռ
+	 *	һֽʱеĽڵ㶼λڸڴ飬ԭڴȫ黹ϵͳ
+	 *	ڼڴռƽʱҲʹڵ
+	 *	ڼ롢λеԪֱӷ뱾ֵĽڵأٰơ
+	 *	ֵboolǷδɣΪfalseʱһεýʼµһ
+	 *	compact()ͬ߶ıڵĵַָ򱻰ƽڵĵȫʧЧ
+	 *	locality()O(n)Ĵ۶ڵ㵱ǰľֲԣstruct avl_locality
+	 *	pool_capacity()ؽڵнڵ۵еĽڵۣڹ۲ڴռá
+	 */
+	void relayout(avl_layout = avl_layout_in_order);
+	bool defragment(size_type);
+	avl_locality locality() const;
+
+	size_type pool_capacity() const {
+		return _pool.capacity() + _defrag_pool.capacity();
+	}
+
+	void put(const T&);
+	iterator put(const_iterator, const T&);
+	template <typename... A>
+	iterator emplace_hint(const_iterator, A&&...);
+	template <typename I>
+	size_type put_sorted(I, I);
+	template <typename I>
+	size_type remove_sorted(I, I);
+	bool find(const T&) const;
+	const_iterator locate(const T&) const;
+	const_iterator locate(const_iterator, const T&) const;
+	const_iterator lower_bound(const T&) const;
+	bool remove(const T&);
+	iterator update(const_iterator, const T&);
+	template <typename F>
+	iterator modify(const_iterator, F);
+
+	/*
+	 *	ӿڣfront()back()
+	 *	ֵconst T&СԪأʱO(1)
+	 *	Ϊʱûᵼ²ȷΪ
+	 */
+	const T& front() const {
+		return _first_node()->value;
+	}
+
+	const T& back() const {
+		return _last_node()->value;
+	}
+
+	bool pop_front();
+	bool pop_back();
+
+	/*
+	 *	ӿڣset_journal(bool)journaling()version()journal_floor()
+	 *	ûѯ޸־úÿʵʲɾԪض־׷һ¼
+	 *	clear()ֻһǣڵ汾ʱֻ贫䷢޸ġ
+	 *	version()صǰİ汾ţǷ־ÿʵ޸Ķʹ1
+	 *	journal_floor()ؿ汾
+	 *	־ʱӵǰ汾ʼ¼ر־ʱм¼
+	 *	־ֻڱ󣺿clone()õ־
+	 *	ֵΪ־ڴʧʱм¼Ҫơ
+	 */
+	void set_journal(bool _on) {
+		_journaling = _on;
+		_journal.clear();
+		_journal_base = _journal_floor = _version;
+	}
+
+	bool journaling() const {
+		return _journaling;
+	}
+
+	std::uint64_t version() const {
+		return _version;
+	}
+
+	std::uint64_t journal_floor() const {
+		return _journal_floor;
+	}
+
+	void truncate_journal(std::uint64_t);
+
+	/*
+	 *	ӿڣset_hash_index(double)hash_index()hash_index_memory()
+	 *	ûѯɢúfindlocate(const T&)remove
+	 *	Լеֵʱֱɢбλڵ㣬ʱO(1)Ըڵ½
+	 *	䡢ָҵȣȻֻʹ
+	 *	
+	 *	_max_loadװʣȡֵ(0, 0.9]Ϊ0ʱرͷڴ档
+	 *	װԽͲԽ죬ڴԽࣺÿԪԼռ16ֽڣ64λƽ̨װʡ
+	 *	ֵboolǷáֻstd::hash<T>ʹĬϱȽʱã
+	 *	ΪڴʧʱرգĲӰ졣
+	 */
+	bool set_hash_index(double _max_load);
+
+	double hash_index() const {
+		return _index ? _index->max_load() : 0;
+	}
+
+	size_type hash_index_memory() const {
+		return _index ? _index->memory() : 0;
+	}
+
+	/*
+	 *	ӿڣset_membership_filter(double, size_type)membership_filter()
+	 *	ûѯǰĳԱֿ鲼¡úfindlocate(const T&)
+	 *	removeȲѯһûеֱֵӷأ
+	 *	ڲҶյĳϣеĲҪึһιĲѯ
+	 *	ʱֵɾʱڹڵֵ۵һ̶ȡ
+	 *	Ԫʱһ޸ĲаǰԪؽʱO(n)
+	 *	
+	 *	_fprĿʣȡֵ(0, 0.5]Ϊ0ʱرչͷڴ档
+	 *	_max_bytesڴޣֽڣΪ0ʱޣԼʱʵʿܸĿֵ
+	 *	ֵboolǷáɢһֻstd::hash<T>ʹĬϱȽʱã
+	 *	ΪڴʧʱرգĲӰ졣
+	 *	membership_filter()عʡڴռõ״̬struct avl_filter_stats
+	 */
+	bool set_membership_filter(double _fpr, size_type _max_bytes = 0);
+	avl_filter_stats membership_filter() const;
+
+	/*
+	 *	ӿڣset_capacity(size_type, avl_eviction)capacity()cache_stats()reset_cache_stats()
+	 *	Ϊ޵򻺴棺ԪʹԪظ_capacityʱ
+	 *	ͬһputа_policy̭ԪأֱԪظ_capacity
+	 *	̭СԪʱֱȡһˣң²ԪرҲܱ̭
+	 *	LRṶʱ²Ԫزᱻ̭ÿ̭ɨ賣ڵ㡣
+	 *	̭Ԫremoveɾһ汾޸־ÿ̭ĴΪO(log n)
+	 *	put_sortedԼapply_deltaȫ̭֮
+	 *	
+	 *	_capacityޣΪ0ʱĬϣǰԪظѳʱ̭
+	 *	_policy̭ԣenum avl_eviction
+	 *	ʱfindlocateдڵķλм˲á
+	 *	ֻʱۼƣstruct avl_cache_stats
+	 */
+	void set_capacity(size_type _capacity, avl_eviction _policy = avl_evict_lru);
+
+	size_type capacity() const {
+		return _bound;
+	}
+
+	avl_cache_stats cache_stats() const {
+		avl_cache_stats _result;
+		_result.hits = _hits;
+		_result.misses = _misses;
+		_result.evictions = _evictions;
+		return _result;
+	}
+
+	void reset_cache_stats() {
+		_hits = _misses = _evictions = 0;
+	}
+
+	bool delta_since(std::uint64_t, avl_delta<T>&) const;
+	void apply_delta(const avl_delta<T>&);
+	iterator erase(const_iterator);
+	iterator erase(const_iterator, const_iterator);
+	template <typename P>
+	size_type erase_if(P);
+	void clear();
+
+	/*
+	 *	ӿڣempty()
+	 *	ޡ
+	 *	ֵboolָʾAVLǷΪա
+	 */
+	bool empty() const {
+		// пֻʣĹ_sizeжϡ
+		return !_size;
+	}
+
+	/*
+	 *	ӿڣsize()
+	 *	ޡ
+	 *	ֵtypename avl<T, C, S, B>::size_type(std::size_t)
+	 *	ָʾAVLĴС
+	 */
+	size_type size() const {
+		// Ϊڽнڵɾʱ_sizeֶξõ£
+		// Դ˽ӿڼ򵥵ط_sizeֶΡ
+		return _size;
+	}
+
+	avl_stats_snapshot stats() const;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator cbegin() const;
+	const_iterator cend() const;
+	reverse_iterator rbegin();
+	reverse_iterator rend();
+	const_reverse_iterator rbegin() const;
+	const_reverse_iterator rend() const;
+	const_reverse_iterator crbegin() const;
+	const_reverse_iterator crend() const;
+};
+
+/*
+ *	class template _avl_iteratorAVLĵ
+ *	ģclass template avlһ˴׸
+ *	̳std::iterator<std::bidirectional_iterator_tag, const T>,
+ *	˱ǩ˫ʵԡ
+ */
+template <typename T, typename C = std::less<T>, typename S = avl_no_stats, typename B = avl_strict_balance>
+class _avl_iterator : public std::iterator<std::bidirectional_iterator_tag, const T> {
+	// ͬAVLԪȨޡ
+	friend class avl<T, C, S, B>;
+
+private:
+
+	// ˽ֶΣ_containerΪconst avl<T, C, S, B>*ʾ
+	const avl<T, C, S, B>* _container;
+
+	// ˽ֶΣ_valueΪconst typename avl<T, C, S, B>::_node*ʾǰָĽڵ㡣
+	const typename avl<T, C, S, B>::_node* _value;
+
+	/*
+	 *	˽йָָָڵָ롣
+	 */
+	_avl_iterator(const avl<T, C, S, B>* _cont, const typename avl<T, C, S, B>::_node* _node) : _container
+
+	(_cont), _value(_node) {}
+
+public:
+
+	/*
+	 *	ӿڣĬϹ
+	 *	ɴ˹ĵЧڡβ
+	 */
+	_avl_iterator() : _avl_iterator(nullptr, nullptr) {}
+
+	/*
+	 *	ӿڣ캯ֵ
+	 *	ṩBitwise Copy Semantics㱾Ҫ
+	 *	ƶ
+	 */
+	_avl_iterator(const _avl_iterator&) = default;
+	_avl_iterator& operator=(const _avl_iterator&) = default;
 	~_avl_iterator() = default;
 
 	/*
-	 *	ӿڣ
-	 *	ֵconst T&ӵָλԪء
-	 *	Чᵼ²ȷΪ
+	 *	ӿڣ
+	 *	ֵconst T&ӵָλԪء
+	 *	Чᵼ²ȷΪ
+	 */
+	const T& operator*() const {
+		return _value->value;
+	}
+
+	/*
+	 *	ӿڣͷ
+	 *	ֵصָλԪصĵַ
+	 *	غָ뽫ᱻһʩӼͷ
+	 *	ʹΪڽָ롣
+	 */
+	const T* operator->() const {
+		return &(_value->value);
+	}
+	_avl_iterator& operator++();
+	_avl_iterator operator++(int);
+	_avl_iterator& operator--();
+	_avl_iterator operator--(int);
+
+	/*
+	 *	ӿڣ
+	 *	
+	 *	_lhsȽϵĵ
+	 *	_rhsȽϵĵ
+	 *	ֵboolָʾǷȡ
+	 */
+	friend bool operator==(const _avl_iterator& _lhs, const _avl_iterator& _rhs) {
+		// ڲͬĽڵһͬ
+		// Ƕβ
+		// βͬģ
+		// ѭֹ㷨䡣
+		return _lhs._value == _rhs._value;
+	}
+};
+
+/*
+ *	ӿڣ_avl_iterator<T, C, S, B>::operator++()/ǰõ
+ *	ýӿھ˵ڶƶ
+ *	operator++ķʽ
+ *	ƶǰڵĺ̡
+ *	߱뱣֤Ч򽫳ֲȷΪ
+ */
+template <typename T, typename C, typename S, typename B>
+_avl_iterator<T, C, S, B>& _avl_iterator<T, C, S, B>::operator++() {
+	// ƶеḷ́ɾµĹ
+	// ڶĩβԪأָĵʹΪβ
+	do
+		_value = avl<T, C, S, B>::_successor(_value);
+	while (_value && _value->dead);
+	return *this;
+}
+
+/*
+ *	ӿڣ_avl_iterator<T, C, S, B>::operator++(int)/õ
+ *	Եǰе޸֮ǰĵ
+ */
+template <typename T, typename C, typename S, typename B>
+_avl_iterator<T, C, S, B> _avl_iterator<T, C, S, B>::operator++(int) {
+	_avl_iterator<T, C, S, B> _prev = *this;
+	++* this;
+	return _prev;
+}
+
+/*
+ *	ӿڣ_avl_iterator<T, C, S, B>::operator--()/ǰõݼ
+ *	ǰõΪ𽫵ƶǰ
+ *	ΪβҰһЧ
+ *	òὫƶAVLһڵ㡣
+ *	ΪβδһЧ
+ *	òȷΪ
+ *	Ϊ׵òὫΪβ
+ */
+template <typename T, typename C, typename S, typename B>
+_avl_iterator<T, C, S, B>& _avl_iterator<T, C, S, B>::operator--() {
+
+	// valueΪգ򽫵ƶһڵ㡣
+	// Ϊգֲ䡣
+	// NoteδһЧȷΪ
+	if (!_value) {
+		_value = _container->_last_node();
+		return *this;
+	}
+
+	// ²Ϊoperator++()еľ
+	do
+		_value = avl<T, C, S, B>::_predecessor(_value);
+	while (_value && _value->dead);
+	return *this;
+}
+
+/*
+ *	ӿڣ_avl_iterator<T, C, S, B>::operator--(int)/õݼ
+ *	Եǰִеݼ޸֮ǰĵ
+ */
+template <typename T, typename C, typename S, typename B>
+_avl_iterator<T, C, S, B> _avl_iterator<T, C, S, B>::operator--(int) {
+	_avl_iterator<T, C, S, B> _prev = *this;
+	--* this;
+	return _prev;
+}
+
+/*
+ *	ӿڣ
+ *	
+ * 	_lhsȽϵĵ
+ *	_rhsȽϵĵ
+ *	ֵboolָʾǷ񲻵ȡ
+ */
+template <typename T, typename C, typename S, typename B>
+bool operator!=(const _avl_iterator<T, C, S, B>& _lhs, const _avl_iterator<T, C, S, B>& _rhs) {
+
+	//ò򵥵operator==ࡣ
+	return !(_lhs == _rhs);
+}
+
+/*
+ *	_swap_node
+ *	ڽڵAVLеλá
+ *	
+ *	_nĽڵ㡣
+ *	_prevĽڵ㡣ȷʵûʲô壬Ҳ:-)
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_swap_node(typename avl<T, C, S, B>::_node* _n, typename avl<T, C, S, B>::_node* _prev) {
+
+	// lambdaʽȳдĺ
+	auto _swap = [](typename avl<T, C, S, B>::_node*& _lhs, typename avl<T, C, S, B>::_node*& _rhs) {
+		auto _temp = _lhs;
+		_lhs = _rhs;
+		_rhs = _temp;
+	};
+
+	/*
+	 *	1.ǵĸס
+	 *	ͬʱø׵ӽڵָ롣
+	 *	Ըڵ⴦ͬʱҪthis->_rootֵָ
 	 */
-	const T& operator*() const {
-		return _value->value;
+	if (_n->parent) {
+		if (_is_left_child(_n->parent, _n))
+			_n->parent->leftChild = _prev;
+		else
+			_n->parent->rightChild = _prev;
+	}
+	else
+		_root = _prev;
+	if (_prev->parent) {
+		if (_is_left_child(_prev->parent, _prev))
+			_prev->parent->leftChild = _n;
+		else
+			_prev->parent->rightChild = _n;
+	}
+	else
+		_root = _n;
+	_swap(_n->parent, _prev->parent);
+
+	// 2.ǺǵĶӵӡ
+	if (_n->leftChild)
+		_n->leftChild->parent = _prev;
+	if (_n->rightChild)
+		_n->rightChild->parent = _prev;
+	if (_prev->leftChild)
+		_prev->leftChild->parent = _n;
+	if (_prev->rightChild)
+		_prev->rightChild->parent = _n;
+	_swap(_n->rightChild, _prev->rightChild);
+	_swap(_n->leftChild, _prev->leftChild);
+
+	// 3.ǵƽӡ
+	std::ptrdiff_t _n_factor = _n->factor;
+	_n->factor = _prev->factor;
+	_prev->factor = _n_factor;
+}
+
+/*
+ *	_successor_predecessor
+ *	ڵеĺǰĹʱؿָ룬_avl_successor
+ */
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_successor(const typename avl<T, C, S, B>::_node* _n) {
+	return _avl_successor(_n);
+}
+
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_predecessor(const typename avl<T, C, S, B>::_node* _n) {
+	return _avl_predecessor(_n);
+}
+
+/*
+ *	_first_node_last_node
+ *	ֵconst typename avl<T, C, S, B>::_node*еһһĹĽڵ㣬
+ *	ûĽڵʱؿָ롣
+ *	_leftmost_rightmostûĹʱʱO(1)
+ */
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_first_node() const {
+	const _node* _p = _leftmost;
+	while (_p && _p->dead)
+		_p = _successor(_p);
+	return _p;
+}
+
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_last_node() const {
+	const _node* _p = _rightmost;
+	while (_p && _p->dead)
+		_p = _predecessor(_p);
+	return _p;
+}
+
+/*
+ *	_reset_extremes
+ *	Ľṹ滻֮ؽָϲƣ_leftmost_rightmost
+ *	ʱO(log n)
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_reset_extremes() {
+	_leftmost = _rightmost = _root;
+	if (!_root)
+		return;
+	while (_leftmost->leftChild)
+		_leftmost = _leftmost->leftChild;
+	while (_rightmost->rightChild)
+		_rightmost = _rightmost->rightChild;
+}
+
+/*
+ *	_bury_node_revive_node
+ *	ڵΪĹĹָΪͨڵ㣬Ӧظ_size_dead
+ *	ĹĹֵѹ
+ *	ѹֻӽڵ㣬ڵĵַ䣬ָǵĵȻЧ
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_bury_node(typename avl<T, C, S, B>::_node* _n) {
+	_n->dead = true;
+	_size--;
+	_dead++;
+	_log(_n->value, true);
+	if (_dead > _lazy * static_cast<double>(_size + _dead))
+		compact();
+}
+
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_revive_node(typename avl<T, C, S, B>::_node* _n) {
+	_n->dead = false;
+	_size++;
+	_dead--;
+	_log(_n->value, false);
+}
+
+/*
+ *	_find_position
+ *	ָڵ㿪ʼ²ңȷ_valӦλá
+ *	
+ *	_nʼҵĽڵ㡣
+ *	_valֵ
+ *	_parent½ڵĸڵ㣬Ϊʱʾ½ڵ㽫Ϊڵ㡣
+ *	_left½ڵǷΪ_parent
+ *	ֵtypename avl<T, C, S, B>::_node*AVL_valȡĽڵ򷵻ظýڵ㣬
+ *	򷵻nullptr
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_find_position(typename avl<T, C, S, B>::_node* _n, typename avl<T, C, S, B>::_key_type _val,
+	typename avl<T, C, S, B>::_node*& _parent, bool& _left) const {
+	_parent = nullptr;
+	_left = false;
+
+	/*
+	 * ͣÿֻж_valǷСڡǰڵ㣬ԱȽϽΪ±ѡ
+	 * ޷֧Ĵ롣;м¼һʱĽڵ_last
+	 * ǲ_valڵ㣬_valȽһμжǷСȡĽڵ㡣
+	 */
+	if (_avl_fast_key<T, C>::value) {
+		_node* _last = nullptr;
+		while (_n) {
+			this->_stat_compare();
+			bool _less = _comparator(_val, _n->value);
+			_node* const _next[2] = { _n->rightChild, _n->leftChild };
+			_last = _less ? _last : _n;
+			_parent = _n;
+			_left = _less;
+			_n = _next[_less];
+		}
+		if (_last && !_comparator(_last->value, _val))
+			return _last;
+		return nullptr;
+	}
+
+	_probe _p(_val);
+	while (_n) {
+		int _result = _compare(_p, _n);
+		if (!_result)
+			return _n;
+		_parent = _n;
+		_left = _result == -1;
+		_n = _left ? _n->leftChild : _n->rightChild;
+	}
+	return nullptr;
+}
+
+/*
+ *	_hint_position
+ *	ʾڵȷ_valӦλá
+ *	_valǡӦλ_hintǰ֮䣨_hintΪʱʾλһڵ֮󣩣
+ *	ֻڵĽڵȽϼȷλã˻صӸڵ㿪ʼĲҡ
+ *	뷵ֵͬ_find_position_hintΪձʾβλá
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_hint_position(typename avl<T, C, S, B>::_node* _hint, const T& _val,
+	typename avl<T, C, S, B>::_node*& _parent, bool& _left) const {
+	if (!_root)
+		return _find_position(_root, _val, _parent, _left);
+
+	// _hintΪ磬ȡ_valڵĽڵ_before_after
+	_node* _after = _hint;
+	_node* _before = nullptr;
+	if (_hint) {
+		int _result = _compare(_val, _hint->value);
+		if (!_result)
+			return _hint;
+
+		// _val_hint֮󣺸_hintĺΪ硣
+		if (_result == 1) {
+			_before = _hint;
+			_after = const_cast<_node*>(_successor(_hint));
+			if (_after) {
+				_result = _compare(_val, _after->value);
+				if (!_result)
+					return _after;
+				if (_result == 1)
+					return _find_position(_root, _val, _parent, _left);
+			}
+		}
+		else
+			_before = const_cast<_node*>(_predecessor(_hint));
+	}
+	else
+		_before = _rightmost;
+
+	// _valǷλ_before֮_beforeΪգ_afterǵһڵ㡣
+	if (_before && _before != _hint) {
+		int _result = _compare(_val, _before->value);
+		if (!_result)
+			return _before;
+		if (_result == -1)
+			return _find_position(_root, _val, _parent, _left);
+	}
+
+	/*
+	 *	ʱ_before < _val < _afterڣ
+	 *	_beforeû_afterû߱ؾһ
+	 */
+	if (_before && !_before->rightChild) {
+		_parent = _before;
+		_left = false;
+	}
+	else {
+		_parent = _after;
+		_left = true;
+	}
+	return nullptr;
+}
+
+/*
+ *	_finger_node
+ *	_nظڵϻݣҵ_valС
+ *	_valλ_n֮ǰΪϻʱ
+ *	ǰڵ丸ڵ򸸽ڵ_n󣬲رȽϣݣ
+ *	ǰڵ丸ڵ򸸽ڵǱȵǰСĵһȣ
+ *	_val_valֻλڵǰУֹͣݣ
+ *	_valȣҵݡ
+ *	_valλ_n֮֮Ϊ
+ *	
+ *	_nĽڵ㣬Ϊա
+ *	_valҵֵ
+ *	_foundָʾǷҵ_valȡĽڵ㡣
+ *	ֵtypename avl<T, C, S, B>::_node*_foundΪtrueʱΪȡĽڵ㣬
+ *	ΪӦ²ҵĸڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_finger_node(const typename avl<T, C, S, B>::_node* _n, const T& _val, bool& _found) const {
+	_found = false;
+	int _result = _compare(_val, _n->value);
+	if (!_result) {
+		_found = true;
+		return const_cast<_node*>(_n);
+	}
+	while (_n->parent) {
+		auto _p = _n->parent;
+		bool _outside = _result == -1 ? _p->rightChild == _n : _p->leftChild == _n;
+		if (_outside) {
+			int _r = _compare(_val, _p->value);
+			if (!_r) {
+				_found = true;
+				return _p;
+			}
+			if (_r != _result)
+				break;
+		}
+		_n = _p;
+	}
+	return const_cast<_node*>(_n);
+}
+
+/*
+ *	_attach_node
+ *	½ڵҵָλãȻ¶ϵƽ⡣
+ *	
+ *	_parent½ڵĸڵ㣬Ϊʱ½ڵΪڵ㡣
+ *	_left½ڵǷΪ_parent
+ *	_n½ڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_attach_node(typename avl<T, C, S, B>::_node* _parent, bool _left, typename avl<T, C, S, B>::_node* _n) {
+	_n->parent = _parent;
+	if (!_parent)
+		_root = _n;
+	else if (_left)
+		_parent->leftChild = _n;
+	else
+		_parent->rightChild = _n;
+	if (!_parent || (_left && _parent == _leftmost))
+		_leftmost = _n;
+	if (!_parent || (!_left && _parent == _rightmost))
+		_rightmost = _n;
+	_size++;
+	_log(_n->value, false);
+	_index_insert(_n);
+	_retrace_insert(_n);
+}
+
+/*
+ *	_retrace_insert
+ *	ڵӸýڵڵݣƽӲڱҪʱת
+ *	AVLĻ_avl_retrace_insertɣȵƽԼ_rank_insert
+ *	
+ *	_n²Ľڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_retrace_insert(typename avl<T, C, S, B>::_node* _n) {
+	if (B::ranked) {
+		_rank_insert(_n);
+		return;
+	}
+	avl_rotation _kind = avl_rotate_ll;
+	if (_avl_retrace_insert(_n, _root, _kind))
+		this->_stat_rotate(_kind);
+}
+
+/*
+ *	_rank
+ *	ֵstd::ptrdiff_tȵƽ½ڵȣΪ-1
+ */
+template <typename T, typename C, typename S, typename B>
+std::ptrdiff_t avl<T, C, S, B>::_rank(const typename avl<T, C, S, B>::_node* _n) {
+	return _n ? _n->factor : -1;
+}
+
+/*
+ *	_rank_insert
+ *	ȵƽ£ڵ¶ϻָȵĹ
+ *	½ڵΪ0븸ڵͬȲΪ0
+ *	ֵܽڵȲΪ1ʱڵȣ֮һ㣻
+ *	һεת˫תݽ
+ *	˲תΣȵľ̯ΪO(1)
+ *	
+ *	_n²Ľڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_rank_insert(typename avl<T, C, S, B>::_node* _n) {
+	for (auto _p = _n->parent; _p && _p->factor == _n->factor; _n = _p, _p = _p->parent) {
+		bool _left = _p->leftChild == _n;
+		auto _sibling = _left ? _p->rightChild : _p->leftChild;
+		if (_p->factor - _rank(_sibling) == 1) {
+			_p->factor++;
+			continue;
+		}
+
+		// _nǰѱȣǡһȲΪ1ӽڵ㡣
+		// ӽڵʱתڲʱ˫ת
+		auto _inner = _left ? _n->rightChild : _n->leftChild;
+		if (_n->factor - _rank(_inner) != 1) {
+			this->_stat_rotate(_left ? avl_rotate_ll : avl_rotate_rr);
+			if (_left)
+				_ll_rotate(_p);
+			else
+				_rr_rotate(_p);
+			_p->factor--;
+		}
+		else {
+			this->_stat_rotate(_left ? avl_rotate_lr : avl_rotate_rl);
+			if (_left)
+				_lr_rotate(_p);
+			else
+				_rl_rotate(_p);
+			_inner->factor++;
+			_n->factor--;
+			_p->factor--;
+		}
+		break;
+	}
+}
+
+/*
+ *	_rank_remove
+ *	AVL£ժ½ڵ¶ϻָȵĹ
+ *	ȴΪ1Ҷڵ㣨ӦΪ0ȻֻҪ_pĳӽڵȲΪ3
+ *	ֵܽڵȲΪ2ֵܽڵӽڵȲΪ2ʱȺϣ
+ *	һεת˫תݽ
+ *	ɾתΣȵľ̯ΪO(1)
+ *	
+ *	_pժ½ڵĸڵ㡣
+ *	_left_pһʧȥ˽ڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_rank_remove(typename avl<T, C, S, B>::_node* _p, bool _left) {
+	std::size_t _steps = 0;
+	if (_p && !_p->leftChild && !_p->rightChild && _p->factor == 1) {
+		_steps++;
+		_p->factor = 0;
+		auto _up = _p->parent;
+		if (_up)
+			_left = _is_left_child(_up, _p);
+		_p = _up;
+	}
+	while (_p) {
+		auto _x = _left ? _p->leftChild : _p->rightChild;
+		if (_p->factor - _rank(_x) != 3)
+			break;
+		_steps++;
+		auto _y = _left ? _p->rightChild : _p->leftChild;
+		if (_p->factor - _rank(_y) == 2)
+			_p->factor--;
+		else if (_y->factor - _rank(_y->leftChild) == 2 && _y->factor - _rank(_y->rightChild) == 2) {
+			_y->factor--;
+			_p->factor--;
+		}
+		else {
+			auto _outer = _left ? _y->rightChild : _y->leftChild;
+			if (_y->factor - _rank(_outer) == 1) {
+				this->_stat_rotate(_left ? avl_rotate_rr : avl_rotate_ll);
+				if (_left)
+					_rr_rotate(_p);
+				else
+					_ll_rotate(_p);
+				_y->factor++;
+				_p->factor--;
+				if (!_p->leftChild && !_p->rightChild)
+					_p->factor = 0;
+			}
+			else {
+				auto _inner = _left ? _y->leftChild : _y->rightChild;
+				this->_stat_rotate(_left ? avl_rotate_rl : avl_rotate_lr);
+				if (_left)
+					_rl_rotate(_p);
+				else
+					_lr_rotate(_p);
+				_inner->factor += 2;
+				_y->factor--;
+				_p->factor -= 2;
+			}
+			break;
+		}
+		auto _up = _p->parent;
+		if (_up)
+			_left = _is_left_child(_up, _p);
+		_p = _up;
+	}
+	this->_stat_retrace(_steps);
+}
+
+/*
+ *	_insert_node
+ *	ָڵΪڵвһԪء
+ *	
+ *	_nָĽڵ㡣
+ *	_valAVLֵ
+ *	ֵtypename avl<T, C, S, B>::_node*洢_valĽڵ㡣
+ *	AVL_valȡԪأ򷵻ԭеĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_insert_node(typename avl<T, C, S, B>::_node* _n, typename avl<T, C, S, B>::_key_type _val) {
+	_node* _parent;
+	bool _left;
+	auto _existing = _find_position(_n, _val, _parent, _left);
+	if (_existing)
+		return _existing;
+	auto _new = _new_node(_val);
+	_attach_node(_parent, _left, _new);
+	return _new;
+}
+
+/*
+ *	_find_node
+ *	
+ *	_nΪconst typename avl<T, C, S, B>::_node*￪ʼҡ
+ *	_valҵԪء
+ *	ֵtypename avl<T, C, S, B>::_node*ֵ
+ *	nullptrδҵֵ
+ *	ǿգֵʾ洢ֵĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_find_node(const typename avl<T, C, S, B>::_node* _n, typename avl<T, C, S, B>::_key_type _val) const {
+
+	// ͣ_find_positionͬÿֻȽһΣ¼С_valСڵ_last
+	// ҶӺж_lastǷ_valȡ
+	if (_avl_fast_key<T, C>::value) {
+		const _node* _last = nullptr;
+		while (_n) {
+			this->_stat_compare();
+			bool _less = _comparator(_n->value, _val);
+			const _node* const _next[2] = { _n->leftChild, _n->rightChild };
+			_last = _less ? _last : _n;
+			_n = _next[_less];
+		}
+		if (_last && !_comparator(_val, _last->value))
+			return _last;
+		return nullptr;
+	}
+
+	// _nΪգؿָʾδҵ
+	// _n_valȡ_nʾҵ
+	// _valСڡ_nʾĽڵֵ_nң_nҡ
+	_probe _p(_val);
+	while (_n) {
+		int _result = _compare(_p, _n);
+		if (!_result)
+			return _n;
+		_n = _result == -1 ? _n->leftChild : _n->rightChild;
+	}
+	return nullptr;
+}
+
+/*
+ *	_remove_node
+ *	һָĽڵ㣬ɾ
+ *	
+ *	_nɾĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_remove_node(typename avl<T, C, S, B>::_node* _n) {
+	_log(_n->value, true);
+	_unlink_node(_n);
+
+	// ռõڴ黹ڵء
+	_delete_node(_n);
+
+	// ΪƳһڵ㣬AVLĴС1
+	_size--;
+
+	// ɳƽ£δṹɾۼƳԪظʱؽ
+	if (_debt > _size)
+		_rebuild();
+}
+
+/*
+ *	_unlink_node
+ *	ָĽڵժ²ƽ⣬ͷҲ޸_size
+ *	_nڵĸڵûиڵ㣬תͽ_rootָµĸڵ㣬
+ *	˶һвʱҪ_rootָĸڵ㡣
+ *	
+ *	_nժµĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_unlink_node(typename avl<T, C, S, B>::_node* _n) {
+
+	// ҵĽڵһӽڵ㣬ᱻֱӸΪĺ̻ǰ
+	if (_n == _leftmost)
+		_leftmost = const_cast<_node*>(_successor(_n));
+	if (_n == _rightmost)
+		_rightmost = const_cast<_node*>(_predecessor(_n));
+
+	// _nӽڵ㣬Ƚǰ
+	// ǰĽڵ㣬һû
+	if (_n->leftChild && _n->rightChild) {
+		auto _prev = _n->leftChild;
+		while (_prev->rightChild)
+			_prev = _prev->rightChild;
+		_swap_node(_n, _prev);
 	}
 
-	/*
-	 *	ӿڣͷ
-	 *	ֵصָλԪصĵַ
-	 *	غָ뽫ᱻһʩӼͷ
-	 *	ʹΪڽָ롣
-	 */
-	const T* operator->() const {
-		return &(_value->value);
+	// ʱ_nһӽڵ㣬ӽڵ㣨Ϊգ_nλá
+	auto _child = _n->leftChild ? _n->leftChild : _n->rightChild;
+	auto _prev_parent = _n->parent;
+	bool _from_left = false;
+	if (_child)
+		_child->parent = _prev_parent;
+	if (_prev_parent) {
+		_from_left = _is_left_child(_prev_parent, _n);
+		if (_from_left)
+			_prev_parent->leftChild = _child;
+		else
+			_prev_parent->rightChild = _child;
+	}
+	else
+		_root = _child;
+	_n->leftChild = _n->rightChild = _n->parent = nullptr;
+	_n->factor = 0;
+
+	// ȵƽдAVLȵĹݣɳƽֻ¼ɾ
+	if (B::ranked) {
+		if (B::rebalance_on_remove)
+			_rank_remove(_prev_parent, _from_left);
+		else
+			_debt++;
+		return;
 	}
-	_avl_iterator& operator++();
-	_avl_iterator operator++(int);
-	_avl_iterator& operator--();
-	_avl_iterator operator--(int);
 
 	/*
-	 *	ӿڣ
-	 *	
-	 *	_lhsȽϵĵ
-	 *	_rhsȽϵĵ
-	 *	ֵboolָʾǷȡ
+	 *	ӱɾڵĸڵڵݣҽе
+	 *	_from_leftʾ_pһĸ߶ȼ1
+	 *	_pƽΪ1_pΪ߶Ȳ䣬ݽ
+	 *	Ϊ0߶ȼ1Ҫϻݣ
+	 *	Ϊ2ҪתתǰϸһƽΪ0
+	 *	ת߶Ȳ䣬ݽ߶ȼ1ϻݡ
 	 */
-	friend bool operator==(const _avl_iterator& _lhs, const _avl_iterator& _rhs) {
-		// ڲͬĽڵһͬ
-		// Ƕβ
-		// βͬģ
-		// ѭֹ㷨䡣
-		return _lhs._value == _rhs._value;
+	std::size_t _steps = 0;
+	for (auto _p = _prev_parent; _p; ) {
+		_steps++;
+		if (_from_left)
+			_p->factor--;
+		else
+			_p->factor++;
+		if (_p->factor == 1 || _p->factor == -1)
+			break;
+		if (_p->factor != 0) {
+			auto _taller = _p->factor > 0 ? _p->leftChild : _p->rightChild;
+			bool _height_kept = _taller->factor == 0;
+			_p = _check_tree(_p);
+			if (_height_kept)
+				break;
+		}
+		auto _up = _p->parent;
+		if (_up)
+			_from_left = _is_left_child(_up, _p);
+		_p = _up;
 	}
-};
+	this->_stat_retrace(_steps);
+}
 
 /*
- *	ӿڣ_avl_iterator<T, C>::operator++()/ǰõ
- *	ýӿھ˵ڶƶ
- *	operator++ķʽ
- *	ƶǰڵĺ̡
- *	߱뱣֤Ч򽫳ֲȷΪ
+ *	_height
+ *	ƽ_nΪĸ߶ȣؽϸߵһ¡
+ *	ʱO(log n)ĸ߶Ϊ0
+ *	ȵƽ·ȼ1Ǹ߶ȵϽ磬ʱO(1)
  */
-template <typename T, typename C>
-_avl_iterator<T, C>& _avl_iterator<T, C>::operator++() {
-	// 1ǰڵҶڵ㣬Ҫϱ
-	if (!_value->leftChild && !_value->rightChild) {
-		// ¼丸ڵ㡣
-		const typename avl<T, C>::_node* _parent = _value->parent;
-		/*
-		 *	ΪڵĺǸڵ㡣
-		 *	Ϊڵ丸ڵϻݣ
-		 *	ֱ˽ڵ丸ڵڵ㣬
-		 *	˽ڵĺ̡
-		 *	ڶĩβԪأָĵʹΪβ
-		 */
-		if (_parent->leftChild == _value) {
-			_value = _parent;
+template <typename T, typename C, typename S, typename B>
+std::size_t avl<T, C, S, B>::_height(const typename avl<T, C, S, B>::_node* _n) {
+	if (B::ranked)
+		return _n ? static_cast<std::size_t>(_n->factor) + 1 : 0;
+	std::size_t _h = 0;
+	for (; _n; _n = _n->factor < 0 ? _n->rightChild : _n->leftChild)
+		_h++;
+	return _h;
+}
+
+/*
+ *	_joinİ汾
+ *	_l_rԼڵ_kϲΪһAVL
+ *	Ҫ_lеԪؾСڡ_k_rеԪؾڡ_k
+ *	߶1_kֱӳΪµĸڵ㣻
+ *	ؽϸһļ½ҵ߶ϰ൱Ľڵ㣬
+ *	_kͬϰڸôٰķʽϻݵ
+ *	ʱO(|߶Ȳ| + 1)
+ *	
+ *	_l_lh߶ȡ
+ *	_kӵĽڵ㡣
+ *	_r_rh߶ȡ
+ *	_hϲĸ߶ȡ
+ *	ֵtypename avl<T, C, S, B>::_node*ϲĸڵ㡣
+ *	ע⣺_root¼ϲеĸڵ㣬лָ_root
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_join(typename avl<T, C, S, B>::_node* _l, std::size_t _lh,
+	typename avl<T, C, S, B>::_node* _k, typename avl<T, C, S, B>::_node* _r, std::size_t _rh, std::size_t& _h) {
+	if (_lh <= _rh + 1 && _rh <= _lh + 1) {
+		_k->leftChild = _l;
+		_k->rightChild = _r;
+		_k->parent = nullptr;
+		if (_l)
+			_l->parent = _k;
+		if (_r)
+			_r->parent = _k;
+		_k->factor = static_cast<std::ptrdiff_t>(_lh) - static_cast<std::ptrdiff_t>(_rh);
+		_h = (_lh > _rh ? _lh : _rh) + 1;
+		return _k;
+	}
+	bool _left_taller = _lh > _rh;
+	_node* _c = _left_taller ? _l : _r;
+	std::size_t _ch = _left_taller ? _lh : _rh;
+	std::size_t _target = (_left_taller ? _rh : _lh) + 1;
+
+	// ؽϸҼ󼹣½ֱڵ߶Ȳϰĸ߶ȼ1
+	// ½ٽһ_p¼_cĸڵ㣨_cΪգ
+	_node* _p = nullptr;
+	while (_ch > _target) {
+		_p = _c;
+		if (_left_taller) {
+			_ch -= _c->factor > 0 ? 2 : 1;
+			_c = _c->rightChild;
 		}
 		else {
-			const typename avl<T, C>::_node* _p = _value;
-			while ((_p->parent) && (_p->parent->rightChild == _p))
-				_p = _p->parent;
-			_value = _p->parent;
+			_ch -= _c->factor < 0 ? 2 : 1;
+			_c = _c->leftChild;
 		}
 	}
+
+	// _k滻_cλã_cϰΪ_k
+	_k->parent = _p;
+	if (_left_taller) {
+		_p->rightChild = _k;
+		_k->leftChild = _c;
+		_k->rightChild = _r;
+		if (_r)
+			_r->parent = _k;
+		_k->factor = static_cast<std::ptrdiff_t>(_ch) - static_cast<std::ptrdiff_t>(_rh);
+	}
 	else {
-		// 2ǰڵ㲻Ҷڵ㣬Ҫ±
-		// ¼
-		const typename avl<T, C>::_node* _p = _value->rightChild;
-		/*
-		 *	ΪգǰڵΪĽڵ㣬
-		 *	Ҫϻݡ
-		 *	ǿգ
-		 *	ֱΪգݶĶ壬˽ڵǵǰڵĺ̡
-		 */
-		if (_p) {
-			while (_p->leftChild)
-				_p = _p->leftChild;
-		}
+		_p->leftChild = _k;
+		_k->rightChild = _c;
+		_k->leftChild = _l;
+		if (_l)
+			_l->parent = _k;
+		_k->factor = static_cast<std::ptrdiff_t>(_lh) - static_cast<std::ptrdiff_t>(_ch);
+	}
+	if (_c)
+		_c->parent = _k;
+
+	// _kΪԭ_c1ķʽϻݡ
+	_root = _left_taller ? _l : _r;
+	_retrace_insert(_k);
+	_h = _height(_root);
+	return _root;
+}
+
+/*
+ *	_joinİ汾
+ *	_l_rϲҪ_lеԪؾСڡ_rеԪء
+ *	_rժСĽڵ㣬
+ *	ע⣺_root¼ϲеĸڵ㣬лָ_root
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_join(typename avl<T, C, S, B>::_node* _l, std::size_t _lh,
+	typename avl<T, C, S, B>::_node* _r, std::size_t _rh, std::size_t& _h) {
+	if (!_r) {
+		_h = _lh;
+		return _l;
+	}
+	if (!_l) {
+		_h = _rh;
+		return _r;
+	}
+	auto _k = _r;
+	while (_k->leftChild)
+		_k = _k->leftChild;
+	_root = _r;
+	_unlink_node(_k);
+	_r = _root;
+	return _join(_l, _lh, _k, _r, _height(_r), _h);
+}
+
+/*
+ *	_split
+ *	һ_keyֳã_lеԪؾСڡ_key_rеԪؾСڡ_key
+ *	Ըڵ£Ѿÿڵͬ_keyǿϲӦһ࣬
+ *	ϲĴ֮ΪO(log n)
+ *	
+ *	_n_nhָ߶ȡ
+ *	_keyָĽޡ
+ *	_l_lh_r_rhָõ߶ȡ
+ *	ע⣺_root¼ϲеĸڵ㣬лָ_root
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_split(typename avl<T, C, S, B>::_node* _n, std::size_t _nh, const T& _key,
+	typename avl<T, C, S, B>::_node*& _l, std::size_t& _lh, typename avl<T, C, S, B>::_node*& _r, std::size_t& _rh) {
+	if (!_n) {
+		_l = _r = nullptr;
+		_lh = _rh = 0;
+		return;
+	}
+
+	// ժ_nƽǵĸ߶ȡ
+	auto _a = _n->leftChild;
+	auto _b = _n->rightChild;
+	std::size_t _ah = _n->factor >= 0 ? _nh - 1 : _nh - 2;
+	std::size_t _bh = _n->factor <= 0 ? _nh - 1 : _nh - 2;
+	if (_a)
+		_a->parent = nullptr;
+	if (_b)
+		_b->parent = nullptr;
+	_n->leftChild = _n->rightChild = _n->parent = nullptr;
+
+	if (_compare(_n->value, _key) == -1) {
+		// _nСڡ_key_n_lָ
+		_node* _bl;
+		std::size_t _blh;
+		_split(_b, _bh, _key, _bl, _blh, _r, _rh);
+		_l = _join(_a, _ah, _n, _bl, _blh, _lh);
+	}
+	else {
+		// _n_rָ
+		_node* _ar;
+		std::size_t _arh;
+		_split(_a, _ah, _key, _l, _lh, _ar, _arh);
+		_r = _join(_ar, _arh, _n, _b, _bh, _rh);
+	}
+}
+
+/*
+ *	_free_subtree
+ *	Ժķʽͷһенڵ㣬ڵ۹黹ڵء
+ *	ֵstd::size_tͷŵĽڵ
+ */
+template <typename T, typename C, typename S, typename B>
+std::size_t avl<T, C, S, B>::_free_subtree(typename avl<T, C, S, B>::_node* _n) {
+	std::size_t _count = 0;
+	while (_n) {
+		if (_n->leftChild)
+			_n = _n->leftChild;
+		else if (_n->rightChild)
+			_n = _n->rightChild;
 		else {
-			_p = _value->parent;
+			auto _parent = _n->parent;
+			if (_parent) {
+				if (_parent->leftChild == _n)
+					_parent->leftChild = nullptr;
+				else
+					_parent->rightChild = nullptr;
+			}
+			_log(_n->value, true);
+			_delete_node(_n);
+			_count++;
+			_n = _parent;
 		}
-		_value = _p;
 	}
-	return *this;
+	return _count;
 }
 
 /*
- *	ӿڣ_avl_iterator<T, C>::operator++(int)/õ
- *	Եǰе޸֮ǰĵ
+ *	_build_tree
+ *	ðеĽڵ´һȫƽʱO(n)
+ *	ÿȡеΪڵ㣬Ľڵ1
+ *	ĸ߶1ƽӿֱ߶á
+ *	ȵƽȵڸ߶ȼ1вԵȵĹ
+ *	
+ *	_nodesеĽڵ㡣
+ *	_countڵ
+ *	_hĸ߶ȡ
+ *	ֵtypename avl<T, C, S, B>::_node*ĸڵ㣬丸ڵΪա
  */
-template <typename T, typename C>
-_avl_iterator<T, C> _avl_iterator<T, C>::operator++(int) {
-	_avl_iterator<T, C> _prev = *this;
-	++* this;
-	return _prev;
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_build_tree(typename avl<T, C, S, B>::_node* const* _nodes, std::size_t _count, std::size_t& _h) {
+	if (!_count) {
+		_h = 0;
+		return nullptr;
+	}
+	std::size_t _mid = _count / 2;
+	std::size_t _lh, _rh;
+	auto _n = _nodes[_mid];
+	_n->parent = nullptr;
+	_n->leftChild = _build_tree(_nodes, _mid, _lh);
+	_n->rightChild = _build_tree(_nodes + _mid + 1, _count - _mid - 1, _rh);
+	if (_n->leftChild)
+		_n->leftChild->parent = _n;
+	if (_n->rightChild)
+		_n->rightChild->parent = _n;
+	_h = (_lh > _rh ? _lh : _rh) + 1;
+	if (B::ranked)
+		_n->factor = static_cast<std::ptrdiff_t>(_h) - 1;
+	else
+		_n->factor = static_cast<std::ptrdiff_t>(_lh) - static_cast<std::ptrdiff_t>(_rh);
+	return _n;
 }
 
 /*
- *	ӿڣ_avl_iterator<T, C>::operator--()/ǰõݼ
- *	ǰõΪ𽫵ƶǰ
- *	ΪβҰһЧ
- *	òὫƶAVLһڵ㡣
- *	ΪβδһЧ
- *	òȷΪ
- *	Ϊ׵òὫΪβ
+ *	_destroy_nodes
+ *	Ժķʽ_currentΪڵеĽڵ㣬_budget
+ *	ڵռõĽڵ۲黹ڵأͷŽڵء
+ *	Tƽڵ㣬ֱӷء
+ *	
+ *	_currentΪtypename avl<T, C, S, B>::_node*ĸڵ㣬һηصļλá
+ *	_budgetĽڵʱȥʵĽڵ
+ *	ֵtypename avl<T, C, S, B>::_node*һμλãΪʱʾȫϡ
  */
-template <typename T, typename C>
-_avl_iterator<T, C>& _avl_iterator<T, C>::operator--() {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_destroy_nodes(typename avl<T, C, S, B>::_node* _current, std::size_t& _budget) {
+	if (std::is_trivially_destructible<T>::value)
+		return nullptr;
 
-	// valueΪգԶȡĸڵ㡣
-	if (!_value) {
+	// һֱ£ֱҶڵ㣻ҶڵӸڵժ£
+	// ٻصڵÿڵ㱻·ʵĴޣÿһڵľ̯ΪO(1)
+	while (_current && _budget) {
+		if (_current->leftChild)
+			_current = _current->leftChild;
+		else if (_current->rightChild)
+			_current = _current->rightChild;
+		else {
+			auto _parent = _current->parent;
+			if (_parent) {
+				if (_parent->leftChild == _current)
+					_parent->leftChild = nullptr;
+				else
+					_parent->rightChild = nullptr;
+			}
+			_current->~_node();
+			_budget--;
+			_current = _parent;
+		}
+	}
+	return _current;
+}
 
-		// NoteδһЧȷΪ
-		auto _p = _container->_root;
+/*
+ *	_make_copy
+ *	ݸ_destС_destΪ
+ *	
+ *	_destΪavl<T, C, S, B>&ƵĿĵء
+ *	_threadsڸƵ߳
+ *	̸߳ʱнڵԤȷһСΪ_sizeڴУ
+ *	˳δš
+ *	̸߳ʱɲɵ̸߳ƣ
+ *	µÿһ̸߳ԵĽڵأ
+ *	ɺ_destĽڵͳһӹܡ
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_make_copy(avl<T, C, S, B>& _dest, std::size_t _threads) const {
 
-		// Ϊգִκβ
-		if (!_p)
-			return *this;
+	// ƿʱ¿
+	if (!_root)
+		return;
 
-		// Ϊգ򽫵ƶһڵ㡣
-		else
-			while (_p->rightChild)
-				_p = _p->rightChild;
-		_value = _p;
-		return *this;
+	// СʱиƵòʧʱ˻Ϊ̸߳ơ
+	constexpr std::size_t _parallel_threshold = 1 << 16;
+	if (_threads <= 1 || _size + _dead < _parallel_threshold) {
+		_dest._pool.reserve(_size + _dead);
+		_dest._root = _copy_node(_root, _dest._pool);
+		_dest._size = _size;
+		_dest._dead = _dead;
+		_dest._debt = _debt;
+		_dest._reset_extremes();
+		_dest._stat_alloc(_size + _dead);
+		return;
+	}
+
+	// ƶ_depth㣬ʹ_depthĿ߳
+	std::size_t _depth = 0;
+	while ((std::size_t(1) << _depth) < _threads)
+		_depth++;
+
+	// иƵԴĿĵصĸڵԼӦڸڵһࡣ
+	struct _task {
+		const _node* src;
+		_node* parent;
+		bool left;
+	};
+	std::vector<_task> _tasks;
+
+	// Բƶ㡣_level浱ǰģԴڵ㣬ĿĽڵ㣩ԡ
+	std::vector<std::pair<const _node*, _node*>> _level, _next;
+	std::size_t _top = 1;
+	_dest._root = _dest._new_node(_root->value);
+	_dest._root->factor = _root->factor;
+	_dest._root->dead = _root->dead;
+	_level.emplace_back(_root, _dest._root);
+	for (std::size_t _d = 1; _d <= _depth; _d++) {
+		_next.clear();
+		for (auto& _pair : _level) {
+			const _node* _children[2] = { _pair.first->leftChild, _pair.first->rightChild };
+			for (int _i = 0; _i < 2; _i++) {
+				if (!_children[_i])
+					continue;
+				if (_d == _depth) {
+					_tasks.push_back({ _children[_i], _pair.second, _i == 0 });
+					continue;
+				}
+				auto _n = _dest._new_node(_children[_i]->value);
+				_top++;
+				_n->factor = _children[_i]->factor;
+				_n->dead = _children[_i]->dead;
+				_n->parent = _pair.second;
+				(_i == 0 ? _pair.second->leftChild : _pair.second->rightChild) = _n;
+				_next.emplace_back(_children[_i], _n);
+			}
+		}
+		_level.swap(_next);
+	}
+
+	// ÿһ̸߳ԵĽڵء
+	std::vector<_avl_node_pool<_node>> _pools(_tasks.size());
+	std::vector<std::future<_node*>> _futures;
+	for (std::size_t _i = 0; _i < _tasks.size(); _i++) {
+		auto _src = _tasks[_i].src;
+		auto _pool_ptr = &_pools[_i];
+		_futures.push_back(std::async(std::launch::async, [_src, _pool_ptr]() {
+			return _copy_node(_src, *_pool_ptr);
+		}));
 	}
 
-	// ²Ϊoperator++()еľ
-	// operator++()еԴעĶ
-	if ((!_value->leftChild) && (!_value->rightChild)) {
-		const typename avl<T, C>::_node* _parent = _value->parent;
-		if (_parent->rightChild == _value) {
-			_value = _parent;
+	// ȴ߳̽ƺõҵӹǵĽڵء
+	// ߳׳쳣߳̽_dest׳
+	std::exception_ptr _error;
+	for (std::size_t _i = 0; _i < _tasks.size(); _i++) {
+		_node* _sub = nullptr;
+		try {
+			_sub = _futures[_i].get();
 		}
-		else {
-			const typename avl<T, C>::_node* _p = _value;
-			while ((_p->parent) && (_p->parent->leftChild == _p))
-				_p = _p->parent;
-			_value = _p->parent;
+		catch (...) {
+			if (!_error)
+				_error = std::current_exception();
+		}
+		_dest._pool.splice(_pools[_i]);
+		if (_sub) {
+			_sub->parent = _tasks[_i].parent;
+			(_tasks[_i].left ? _tasks[_i].parent->leftChild : _tasks[_i].parent->rightChild) = _sub;
 		}
 	}
-	else {
-		const typename avl<T, C>::_node* _p = _value->leftChild;
-		if (_p) {
-			while (_p->rightChild)
-				_p = _p->rightChild;
+	if (_error) {
+		_dest.clear();
+		std::rethrow_exception(_error);
+	}
+	_dest._size = _size;
+	_dest._dead = _dead;
+	_dest._debt = _debt;
+	_dest._reset_extremes();
+	_dest._stat_alloc(_size + _dead - _top);
+}
+
+/*
+ *	_copy_node
+ *	Էǵݹķʽ_srcΪ
+ *	ڵָ˲Ҫջռ䣬
+ *	ڵ㰴˳ӽڵ_toз䡣
+ *	
+ *	_srcԴ
+ *	_toĿĵʹõĽڵء
+ *	ֵtypename avl<T, C, S, B>::_node*Ƶõĸڵ㡣
+ *	ƹTĿ׳쳣ѸƵĽڵᱻ黹ڵء
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_copy_node(const typename avl<T, C, S, B>::_node* _src, _avl_node_pool<typename avl<T, C, S, B>::_node>& _to) {
+	auto _dest_root = _construct_node(_to, _src->value);
+	_dest_root->factor = _src->factor;
+	_dest_root->dead = _src->dead;
+	auto _dest = _dest_root;
+	try {
+		while (_src) {
+
+			// srcδƣ֮
+			if (_src->leftChild && !_dest->leftChild) {
+				_dest->leftChild = _construct_node(_to, _src->leftChild->value);
+				_dest->leftChild->parent = _dest;
+				_dest->leftChild->factor = _src->leftChild->factor;
+				_dest->leftChild->dead = _src->leftChild->dead;
+				_src = _src->leftChild;
+				_dest = _dest->leftChild;
+			}
+
+			// srcδƣ֮
+			else if (_src->rightChild && !_dest->rightChild) {
+				_dest->rightChild = _construct_node(_to, _src->rightChild->value);
+				_dest->rightChild->parent = _dest;
+				_dest->rightChild->factor = _src->rightChild->factor;
+				_dest->rightChild->dead = _src->rightChild->dead;
+				_src = _src->rightChild;
+				_dest = _dest->rightChild;
+			}
+
+			// Ѹϣ򷵻ظڵ㡣ĸʱ
+			else if (_dest == _dest_root)
+				break;
+			else {
+				_src = _src->parent;
+				_dest = _dest->parent;
+			}
 		}
-		else {
-			_p = _value->parent;
+	}
+	catch (...) {
+		// ԺķʽѸƵĽڵ㡣
+		auto _p = _dest_root;
+		while (_p) {
+			if (_p->leftChild)
+				_p = _p->leftChild;
+			else if (_p->rightChild)
+				_p = _p->rightChild;
+			else {
+				auto _parent = _p->parent;
+				if (_parent)
+					(_parent->leftChild == _p ? _parent->leftChild : _parent->rightChild) = nullptr;
+				_p->~_node();
+				_to.deallocate(_p);
+				_p = _p == _dest_root ? nullptr : _parent;
+			}
 		}
-		_value = _p;
+		throw;
 	}
-	return *this;
+	return _dest_root;
 }
 
 /*
- *	ӿڣ_avl_iterator<T, C>::operator--(int)/õݼ
- *	Եǰִеݼ޸֮ǰĵ
+ *	_check_tree
+ *	_nΪڵǷAVLĶ壬ִӦ
+ *	_avl_check_treeɣ˴ֻͳת
+ *	
+ *	_nΪtypename avl<T, C, S, B>::_node*Ľڵ㡣
+ *	ֵtypename avl<T, C, S, B>::_node*Ľڵ㡣
  */
-template <typename T, typename C>
-_avl_iterator<T, C> _avl_iterator<T, C>::operator--(int) {
-	_avl_iterator<T, C> _prev = *this;
-	--* this;
-	return _prev;
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_check_tree(typename avl<T, C, S, B>::_node* _n) {
+	avl_rotation _kind = avl_rotate_ll;
+	auto _top = _avl_check_tree(_n, _root, _kind);
+	if (_top != _n)
+		this->_stat_rotate(_kind);
+	return _top;
 }
 
 /*
- *	ӿڣ
+ *	_ll_rotate
+ *	ָĽڵִL-Lת
  *	
- * 	_lhsȽϵĵ
- *	_rhsȽϵĵ
- *	ֵboolָʾǷ񲻵ȡ
+ *	_nĽڵ㡣
  */
-template <typename T, typename C>
-bool operator!=(const _avl_iterator<T, C>& _lhs, const _avl_iterator<T, C>& _rhs) {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_ll_rotate(typename avl<T, C, S, B>::_node* _n) {
+	return _avl_rotate_right(_n, _root);
+}
 
-	//ò򵥵operator==ࡣ
-	return !(_lhs == _rhs);
+/*
+ *	_rr_rotate
+ *	ָĽڵʵR-Rת
+ *	
+ *	_nĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_rr_rotate(typename avl<T, C, S, B>::_node* _n) {
+	return _avl_rotate_left(_n, _root);
 }
 
 /*
- *	_swap_node
- *	ڽڵAVLеλá
+ *	_lr_rotate
+ *	ָĽڵִL-Rת
  *	
- *	_nĽڵ㡣
- *	_prevĽڵ㡣ȷʵûʲô壬Ҳ:-)
+ *	_nĽڵ㡣
  */
-template <typename T, typename C>
-void avl<T, C>::_swap_node(typename avl<T, C>::_node* _n, typename avl<T, C>::_node* _prev) {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_lr_rotate(typename avl<T, C, S, B>::_node* _n) {
 
-	// lambdaʽȳдĺ
-	auto _swap = [](typename avl<T, C>::_node*& _lhs, typename avl<T, C>::_node*& _rhs) {
-		auto _temp = _lhs;
-		_lhs = _rhs;
-		_rhs = _temp;
-	};
+	// _nִR-Rת
+	_rr_rotate(_n->leftChild);
 
-	/*
-	 *	1.ǵĸס
-	 *	ͬʱø׵ӽڵָ롣
-	 *	Ըڵ⴦ͬʱҪthis->_rootֵָ
-	 */
-	if (_n->parent) {
-		if (_is_left_child(_n->parent, _n))
-			_n->parent->leftChild = _prev;
-		else
-			_n->parent->rightChild = _prev;
-	}
-	else
-		_root = _prev;
-	if (_prev->parent) {
-		if (_is_left_child(_prev->parent, _prev))
-			_prev->parent->leftChild = _n;
-		else
-			_prev->parent->rightChild = _n;
-	}
-	else
-		_root = _n;
-	_swap(_n->parent, _prev->parent);
+	// ٶ_nִL-Lת
+	return _ll_rotate(_n);
+}
 
-	// 2.ǺǵĶӵӡ
-	if (_n->leftChild)
-		_n->leftChild->parent = _prev;
-	if (_n->rightChild)
-		_n->rightChild->parent = _prev;
-	if (_prev->leftChild)
-		_prev->leftChild->parent = _n;
-	if (_prev->rightChild)
-		_prev->rightChild->parent = _n;
-	_swap(_n->rightChild, _prev->rightChild);
-	_swap(_n->leftChild, _prev->leftChild);
 
-	// 3.ǵƽӡ
-	std::ptrdiff_t _n_factor = _n->factor;
-	_n->factor = _prev->factor;
-	_prev->factor = _n_factor;
+/*
+ *	_rl_rotate
+ *	ָĽڵִR-Lת
+ *	
+ *	_nĽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_rl_rotate(typename avl<T, C, S, B>::_node* _n) {
+
+	// _nִL-Lת
+	_ll_rotate(_n->rightChild);
+
+	// ٶ_nִR-Rת
+	return _rr_rotate(_n);
 }
 
 /*
- *	_insert_node
- *	ָڵΪڵвһԪء
+ *	ӿڣput
+ *	һֵAVL
+ *	
+ *	_valueΪconst T&ֵ
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::put(const T& _value) {
+
+	// ģʽ£˳һСȴյĽڵ㡣
+	// ˳ԱʱҪʱؽ
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+
+	// _rootʼ롣
+	this->_stat_op_begin(avl_op_insert);
+	std::size_t _before = _size;
+	auto _n = const_cast<_node*>(_index ? _lookup(_value) : nullptr);
+	if (!_n)
+		_n = _insert_node(_root, _value);
+	if (_n->dead)
+		_revive_node(_n);
+	this->_stat_op_end();
+
+	// ģʽ£Ԫ򰴲̭Ϊһηʡ
+	if (_size > _before)
+		_enforce_capacity(_n);
+	else
+		_n->referenced = true;
+}
+
+/*
+ *	ӿڣput(const_iterator, const T&)
+ *	ʾĲ롣_valueǡӦ_hint֮ǰ_hint֮󣩣
+ *	ֻڵԪرȽϣľ̯ΪO(1)˻ΪͨĲ롣
+ *	ڻ룬һβ뷵صĵΪʾɻõЧ
  *	
- *  _nָĽڵ㡣
- *  _valAVLֵ
+ *	_hintʾλãβ
+ *	_valueΪconst T&ֵ
+ *	ֵiteratorָ洢_valueԪأ²Ļԭеģ
+ *	ģʽ²Ԫ漴̭Ϊβ
  */
-template <typename T, typename C>
-void avl<T, C>::_insert_node(typename avl<T, C>::_node* _n, const T& _val) {
-
-	// AVLΪգôֱڸڵϹ졣
-	if (!_root) {
-		_root = new typename avl<T, C>::_node(_val);
-		_size++;
-		return;
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::put(typename avl<T, C, S, B>::const_iterator _hint, const T& _value) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	this->_stat_op_begin(avl_op_insert);
+	_node* _parent;
+	bool _left;
+	auto _n = _hint_position(const_cast<_node*>(_hint._value), _value, _parent, _left);
+	if (!_n) {
+		_n = _new_node(_value);
+		_attach_node(_parent, _left, _n);
 	}
-
-	// ǰڵֵֵȣôֱӷء
-	auto _result = _compare(_val, _n->value);
-	if (!_result)
-		return;
-
-	// µ̡
+	else if (_n->dead)
+		_revive_node(_n);
 	else {
+		_n->referenced = true;
+		this->_stat_op_end();
+		return iterator(this, _n);
+	}
+	this->_stat_op_end();
+	if (_enforce_capacity(_n))
+		_n = nullptr;
+	return iterator(this, _n);
+}
 
-		// ֵСڡǰڵֵ뵱ǰڵ
-		if (_result == -1) {
-
-			// _nΪ...
-			if (_n->leftChild) {
-
-				// ¼ԭƽӡ
-				auto _prev_factor = _n->leftChild->factor;
-
-				// ݹؽ_val
-				_insert_node(_n->leftChild, _val);
-
-				// ¼ԭȻټ
-				// ǷAVLĶ塣AVLĶӦĵ
-				auto _prev_left = _n->leftChild;
+/*
+ *	ӿڣemplace_hint(const_iterator, A&&...)
+ *	ԸĲ͵عԪأٰput(const_iterator, const T&)ķʽʾ롣
+ *	AVLСȡԪأ¹Ԫر١
+ *	ֵiteratorָ²ԪػԭеġȡԪأ
+ *	ģʽ²Ԫ漴̭Ϊβ
+ */
+template <typename T, typename C, typename S, typename B>
+template <typename... A>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::emplace_hint(typename avl<T, C, S, B>::const_iterator _hint, A&&... _args) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	auto _n = _new_node(std::forward<A>(_args)...);
+	this->_stat_op_begin(avl_op_insert);
+	_node* _parent;
+	bool _left;
+	auto _existing = _hint_position(const_cast<_node*>(_hint._value), _n->value, _parent, _left);
+	this->_stat_op_end();
+	if (_existing) {
+		_delete_node(_n);
+		if (_existing->dead) {
+			_revive_node(_existing);
+			if (_enforce_capacity(_existing))
+				_existing = nullptr;
+		}
+		else
+			_existing->referenced = true;
+		return iterator(this, _existing);
+	}
+	_attach_node(_parent, _left, _n);
+	if (_enforce_capacity(_n))
+		_n = nullptr;
+	return iterator(this, _n);
+}
 
-				// AVLĶ壬δе漰ƽӵı仯
-				// ļ顣
-				if (_prev_left == _check_tree(_prev_left)) {
+/*
+ *	ӿڣupdate(const_iterator, const T&)
+ *	_posָԪظΪ_valueЧɾԭֵٲ_valueͬ·ڵ㡣
+ *	_valueλԭԪصǰ֮䣬͵ظдڵ㣬Ľṹ䣻
+ *	򽫽ڵժ£ԭλڵĽڵָңٹҵµλá
+ *	ƶdλõԪأֻO(log d)αȽϣժһصĵ̯ΪO(1)
+ *	_valueȡԪأɾ_posָԪأбԭеԪء
+ *	
+ *	_posָ޸ԪصЧβ
+ *	_valueµֵ
+ *	ֵiteratorֵָ_valueȡԪء
+ *	_posָԪԪظɾ⣬еȻЧ
+ *	_posԪƶµλá
+ *	Tĸֵ׳쳣ʱ_posָԪرɾ쳣⴫ݡ
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::update(typename avl<T, C, S, B>::const_iterator _pos, const T& _value) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	auto _n = _update_node(const_cast<_node*>(_pos._value), _value);
+	_n->referenced = true;
+	return iterator(this, _n);
+}
 
-					/*
-					 *	ƽӵ0򾭹ĸ߶δ仯
-					 *	_nƽӡ
-					 *	ƽڲǰδ仯ĸ߶Ҳδ仯
-					 *	ı_nƽӡ
-					 *	£_n߶1ƽӼ1
-					 */
-					if (_prev_left->factor != 0 && _prev_left->factor !=
+/*
+ *	ӿڣmodify(const_iterator, F)
+ *	_fn(T&)޸_posָԪصһٰupdate(const_iterator, const T&)ķʽдء
+ *	_fn׳쳣ʱֲ䡣
+ *	ֵiteratorupdate(const_iterator, const T&)ͬ
+ */
+template <typename T, typename C, typename S, typename B>
+template <typename F>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::modify(typename avl<T, C, S, B>::const_iterator _pos, F _fn) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	T _value(*_pos);
+	_fn(_value);
+	auto _n = _update_node(const_cast<_node*>(_pos._value), std::move(_value));
+	_n->referenced = true;
+	return iterator(this, _n);
+}
 
-						_prev_factor)
-						_n->factor++;
-				}
-				else
+/*
+ *	_update_node
+ *	ڵ_nֵΪ_valueڱҪʱƶµλãupdate(const_iterator, const T&)
+ *	ֵtypename avl<T, C, S, B>::_node*ֵ_valueȡĽڵ㡣
+ *	޸־м¼Ϊһɾһβ룬ɢԱ֮¡
+ *	ĹͨڵһռеλãڽڵĹ
+ *	ֵĳĹȡʱĹָЧputͬ
+ */
+template <typename T, typename C, typename S, typename B>
+template <typename V>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_update_node(typename avl<T, C, S, B>::_node* _n, V&& _value) {
+	this->_stat_op_begin(avl_op_insert);
+	auto _before = const_cast<_node*>(_predecessor(_n));
+	auto _after = const_cast<_node*>(_successor(_n));
+	bool _in_place = (!_before || _comparator(_before->value, _value)) && (!_after || _comparator(_value, _after->value));
+	_node* _parent = nullptr;
+	bool _left = false;
+	if (!_in_place) {
+
+		// Ƚ_nժ£ٴ_valueһڽڵµλá
+		// ժָֻ룬_before_afterС
+		auto _finger = _before && !_comparator(_before->value, _value) ? _before : _after;
+		_unlink_node(_n);
+		bool _found;
+		auto _existing = _finger_node(_finger, _value, _found);
+		if (!_found)
+			_existing = _find_position(_existing, _value, _parent, _left);
+		if (_existing) {
+
+			// СȡԪأ_nɾԪĹָ
+			this->_stat_op_end();
+			_log(_n->value, true);
+			_delete_node(_n);
+			_size--;
+			if (_existing->dead)
+				_revive_node(_existing);
+			if (_debt > _size)
+				_rebuild();
+			return _existing;
+		}
+	}
+	this->_stat_op_end();
+
+	// ֵɢƳٸддʧʱڵѲУֱɾ
+	_log(_n->value, true);
+	if (_index)
+		_index->erase(_n, _avl_hash_traits<T, C>::hash(_n->value));
+	try {
+		_n->value = std::forward<V>(_value);
+	}
+	catch (...) {
+		if (_in_place)
+			_unlink_node(_n);
+		_delete_node(_n);
+		_size--;
+		if (_debt > _size)
+			_rebuild();
+		throw;
+	}
+	_avl_key_traits<T, C>::assign(*_n, _n->value);
+	if (_in_place) {
+		_log(_n->value, false);
+		_index_insert(_n);
+		return _n;
+	}
 
-					/*	_check_nodeתƽӵĵ
-					 *	_check_nodeĬתԺԸڵƽӽе
-					 *	УΪ_prev_left_n
-					 *	ڵʱ_nƽӻᱻ1
-					 *	ʵ_prev_leftĸ߶Ȳδ仯ڵʹ߶ȼ1
-					 *	תʹ߶ȼ1
-					 *	ڴ˴貹
-					 */
-					_n->factor++;
-			}
-			else {
+	// _attach_nodeٴμ¼벢_size
+	_size--;
+	_attach_node(_parent, _left, _n);
+	if (_debt > _size)
+		_rebuild();
+	return _n;
+}
 
-				/*
-				 *	ΪգֱӶӾͺˡ
-				 *	AVLĶ֪֮һAVLĶ壬
-				 *	Բü顣
-				 */
-				_n->leftChild = new typename avl<T, C>::_node(_val);
-				_n->leftChild->parent = _n;
-				_size++;
-				_n->factor++;
+/*
+ *	ӿڣput_sorted(I, I)
+ *	[_first, _last)еֵҪѰȽС
+ *	ֵʱÿֵһλóָң
+ *	ΪdֵֻO(log d)αȽϣ
+ *	Ĵklog(n)nʱΪеĽڵ鲢
+ *	O(n + k)ʱ´һȫƽ
+ *	
+ *	_first_lastǰ䣬ԪؿתΪconst T&
+ *	ֵsize_type²ԪظСȡԪصֵ룩
+ */
+template <typename T, typename C, typename S, typename B>
+template <typename I>
+typename avl<T, C, S, B>::size_type avl<T, C, S, B>::put_sorted(I _first, I _last) {
+	if (_first == _last)
+		return 0;
+	if (_graves)
+		reclaim(_reclaim_slice);
+	std::size_t _count = static_cast<std::size_t>(std::distance(_first, _last));
+	std::size_t _before = _size;
+
+	// Ա֮ŰؽʹСԪơ
+	if (_count * _height(_root) < _size + _dead) {
+		_node* _finger = nullptr;
+		for (; _first != _last; ++_first) {
+			const T& _value = *_first;
+			this->_stat_op_begin(avl_op_insert);
+			_node* _parent;
+			bool _left;
+			_node* _n;
+			bool _found = false;
+			if (_finger)
+				_n = _finger_node(_finger, _value, _found);
+			else
+				_n = _root;
+			if (!_found)
+				_n = _find_position(_n, _value, _parent, _left);
+			if (!_n) {
+				_n = _new_node(_value);
+				_attach_node(_parent, _left, _n);
 			}
+			else if (_n->dead)
+				_revive_node(_n);
+			this->_stat_op_end();
+			_finger = _n;
 		}
-		else {
+		std::size_t _added = _size - _before;
+		_enforce_capacity(nullptr);
+		_filter_maintain();
+		return _added;
+	}
 
-			/*
-			 *	ݹΪ
-			 *	ϷԴעĶ
-			 */
-			if (_n->rightChild) {
-				auto _prev_factor = _n->rightChild->factor;
-				_insert_node(_n->rightChild, _val);
-				auto _prev_right = _n->rightChild;
-				if (_prev_right == _check_tree(_prev_right)) {
-					if (_prev_right->factor != 0 && _prev_right->factor !=
-
-						_prev_factor)
-						_n->factor--;
-				}
-				else
-					_n->factor--;
+	// 鲢ռеĽڵ㣬еֵαȽϣֻΪµֵڵ㡣
+	// ڴ֮ǰ޸ԭеĽڵ㣬ʧʱͷ·Ľڵ㼴ɡ
+	if (_dead)
+		compact();
+	std::vector<_node*> _nodes;
+	_nodes.reserve(_size + _count);
+	std::vector<_node*> _fresh;
+	const _node* _p = _root;
+	if (_p)
+		while (_p->leftChild)
+			_p = _p->leftChild;
+	try {
+		this->_stat_op_begin(avl_op_insert);
+		for (; _first != _last; ++_first) {
+			const T& _value = *_first;
+			int _result = 1;
+			while (_p && (_result = _compare(_value, _p->value)) == 1) {
+				_nodes.push_back(const_cast<_node*>(_p));
+				_p = _successor(_p);
 			}
-			else {
-				_n->rightChild = new typename avl<T, C>::_node(_val);
-				_n->rightChild->parent = _n;
-				_size++;
-				_n->factor--;
+			if (!_p || _result == -1) {
+				if (_fresh.empty() || _compare(_fresh.back()->value, _value) == -1) {
+					_fresh.push_back(nullptr);
+					_fresh.back() = _new_node(_value);
+					_nodes.push_back(_fresh.back());
+				}
 			}
 		}
+		this->_stat_op_end();
+	}
+	catch (...) {
+		this->_stat_op_end();
+		for (auto _n : _fresh)
+			if (_n)
+				_delete_node(_n);
+		throw;
+	}
+	for (; _p; _p = _successor(_p))
+		_nodes.push_back(const_cast<_node*>(_p));
+	for (auto _n : _fresh) {
+		_log(_n->value, false);
+		_index_insert(_n);
 	}
+	std::size_t _h;
+	_root = _build_tree(_nodes.data(), _nodes.size(), _h);
+	_reset_extremes();
+	_size = _nodes.size();
+	_debt = 0;
+	std::size_t _added = _size - _before;
+	_enforce_capacity(nullptr);
+	_filter_maintain();
+	return _added;
 }
 
 /*
- *	_find_node
+ *	ӿڣremove_sorted(I, I)
+ *	ɾ[_first, _last)еֵҪѰȽС
+ *	put_sorted(I, I)ͬɾʱɾɾģʽֻĹ
+ *	鲢´
  *	
- *	_nΪconst typename avl<T, C>::_node*￪ʼҡ
- *	_valҵԪء
- *	ֵtypename avl<T, C>::_node*ֵ
- *	nullptrδҵֵ
- *	ǿգֵʾ洢ֵĽڵ㡣
+ *	_first_lastǰ䣬ԪؿתΪconst T&
+ *	ֵsize_typeʵɾԪظ
  */
-template <typename T, typename C>
-const typename avl<T, C>::_node* avl<T, C>::_find_node(const typename avl<T, C>::_node* _n, const T& _val) const {
-
-	// _nΪգֱӷؿָ뼴ɡ
-	// _n_valȡ_nʾҵ
-	
-	if (!_n)
-		return nullptr;
-	int _result = _compare(_val, _n->value);
-	if (!_result)
-		return _n;
-	else {
-
-		// _valСڡ_nʾĽڵֵ_nҡ
-		if (_result == -1)
-			return _find_node(_n->leftChild, _val);
+template <typename T, typename C, typename S, typename B>
+template <typename I>
+typename avl<T, C, S, B>::size_type avl<T, C, S, B>::remove_sorted(I _first, I _last) {
+	if (_first == _last || !_root)
+		return 0;
+	_filter_maintain();
+	std::size_t _count = static_cast<std::size_t>(std::distance(_first, _last));
+	std::size_t _before = _size;
+
+	if (_count * _height(_root) < _size + _dead) {
+		for (; _first != _last; ++_first)
+			remove(*_first);
+		return _before - _size;
+	}
 
-		// _nҡ
-		else
-			return _find_node(_n->rightChild, _val);
+	if (_dead)
+		compact();
+	std::vector<_node*> _keep;
+	_keep.reserve(_size);
+	std::vector<_node*> _drop;
+	const _node* _p = _root;
+	while (_p->leftChild)
+		_p = _p->leftChild;
+	this->_stat_op_begin(avl_op_remove);
+	for (; _first != _last && _p; ++_first) {
+		const T& _value = *_first;
+		int _result = 1;
+		while (_p && (_result = _compare(_value, _p->value)) == 1) {
+			_keep.push_back(const_cast<_node*>(_p));
+			_p = _successor(_p);
+		}
+		if (_p && !_result) {
+			_drop.push_back(const_cast<_node*>(_p));
+			_p = _successor(_p);
+		}
 	}
+	this->_stat_op_end();
+	if (_drop.empty())
+		return 0;
+	for (; _p; _p = _successor(_p))
+		_keep.push_back(const_cast<_node*>(_p));
+	for (auto _n : _drop) {
+		_log(_n->value, true);
+		_delete_node(_n);
+	}
+	std::size_t _h;
+	_root = _build_tree(_keep.data(), _keep.size(), _h);
+	_reset_extremes();
+	_size = _keep.size();
+	_debt = 0;
+	return _before - _size;
 }
 
 /*
- *	_remove_node
- *	һָĽڵ㣬ɾ
+ *	ӿ:find
+ *	һֵǷλAVLС
  *	
- *	_nɾĽڵ㡣
+ *	_valueΪconst T&ҵֵ
+ *	ֵboolʾǷҵ
  */
-template <typename T, typename C>
-void avl<T, C>::_remove_node(typename avl<T, C>::_node* _n) {
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::find(const T& _value) const {
 
-	// _nҶڵ...
-	if (!_n->leftChild && !_n->rightChild) {
+	// ʵʹ_find_node_rootʼҡ
+	// ҵĽڵΪָ룬ûҵ
+	// ҵĽڵǿգҵ
+	this->_stat_op_begin(avl_op_find);
+	auto _n = _lookup(_value);
+	this->_stat_op_end();
+	_touch(_n);
+	return _n && !_n->dead;
+}
 
-		// 丸ڵĸڵƽӡ
-		auto _prev_parent = _n->parent;
-		if (_is_left_child(_prev_parent, _n)) {
-			_prev_parent->leftChild = nullptr;
-			_prev_parent->factor--;
-		}
+/*
+ *	ӿڣlocate(const T&)
+ *	һֵָĵ
+ *	ֵconst_iteratorδҵΪβ
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::locate(const T& _value) const {
+	this->_stat_op_begin(avl_op_find);
+	auto _n = _lookup(_value);
+	this->_stat_op_end();
+	_touch(_n);
+	if (_n && _n->dead)
+		_n = nullptr;
+	return const_iterator(this, _n);
+}
+
+/*
+ *	ӿڣlocate(const_iterator, const T&)
+ *	ָң_fingerָԪس_value
+ *	ظڵϻݣֱĳ_finger֮_value
+ *	ٴӸô²ҡ_fingerdĿ꣬
+ *	ֻͨO(log d)αȽϣ²ͨҵ
+ *	
+ *	_fingerλãΪβʱͬlocate(const T&)
+ *	_valueҵֵ
+ *	ֵconst_iteratorδҵΪβ
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::locate(typename avl<T, C, S, B>::const_iterator _finger, const T& _value) const {
+	auto _n = _finger._value;
+	if (!_n)
+		return locate(_value);
+	this->_stat_op_begin(avl_op_find);
+	bool _found;
+	_n = _finger_node(_n, _value, _found);
+	if (!_found)
+		_n = _find_node(_n, _value);
+	this->_stat_op_end();
+	_touch(_n);
+	if (_n && _n->dead)
+		_n = nullptr;
+	return const_iterator(this, _n);
+}
+
+/*
+ *	ӿڣlower_bound(const T&)
+ *	ҵһСڡ_valueԪء
+ *	ֵconst_iteratorԪضСڡ_valueΪβ
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::lower_bound(const T& _value) const {
+	this->_stat_op_begin(avl_op_find);
+	const _node* _n = _root;
+	const _node* _last = nullptr;
+	while (_n) {
+		this->_stat_compare();
+		if (_comparator(_n->value, _value))
+			_n = _n->rightChild;
 		else {
-			_prev_parent->rightChild = nullptr;
-			_prev_parent->factor++;
+			_last = _n;
+			_n = _n->leftChild;
 		}
+	}
+	this->_stat_op_end();
+	const_iterator _it(this, _last);
+	if (_last && _last->dead)
+		++_it;
+	return _it;
+}
 
-		// ռõڴ黹ϵͳ
-		delete _n;
+/*
+ *	ӿڣremove
+ *	ɾһֵֵλAVLС
+ *	
+ *	_valueΪconst T&ɾֵ
+ *	ֵ
+ *	boolָʾɾǷɹִС
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::remove(const T& _value) {
 
-		// ΪƳһڵ㣬AVLĴС1
-		_size--;
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
 
-		// ӱɾڵĸڵڵ飬ҽе
-		for (auto _p = _prev_parent; _p; _p = _p->parent) {
-			_p = _check_tree(_p);
-		}
+	// ȲҽڵǷAVLС
+	this->_stat_op_begin(avl_op_remove);
+	auto _loc_node = const_cast<typename avl<T, C, S, B>::_node*>(_lookup(_value));
+	this->_stat_op_end();
+
+	// _loc_nodeǿҲĹ˽ڵAVLС
+	if (_loc_node && !_loc_node->dead) {
+
+		// ɾģʽֻĹ_remove_nodeɾڵ㡣
+		// trueʾɹɾ
+		if (_lazy)
+			_bury_node(_loc_node);
+		else
+			_remove_node(_loc_node);
+		return true;
 	}
 	else {
-		// _nҶڵ㡣
-		// _nǰ
-		auto _prev = const_cast<typename avl<T, C>::_node*>((--(_avl_iterator<T, C>(this, _n)))._value);
-
-		// _nǰ
-		_swap_node(_n, _prev);
 
-		// ٳɾ_nջתΪɾҶڵ
-		_remove_node(_n);
+		// δҵڵ㣬falseʾɾʧܡ
+		return false;
 	}
 }
 
 /*
- *	_clear_tree
- *	ɾ_currentΪڵ
- *	
- *	_currentΪtypename avl<T, C>::_node*ɾ
+ *	_log_log_reset_journal_break
+ *	ÿʵ޸Ԫغã汾ż1־ʱ׷Ӽ¼óԱʱһ¡
+ *	_log_reset¼һclear()ǰļ¼ҪԿɴ_journal_floor֮İ汾׷ϡ
+ *	_journal_breakȫ¼ֻơ
+ *	׷Ӽ¼ʧʱ׳쳣Ƕȫ¼֤޸Ĳ־Ӱ졣
  */
-template <typename T, typename C>
-void avl<T, C>::_clear_tree(typename avl<T, C>::_node* _current) {
-
-	// _currentΪգɾ
-	if (!_current)
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_log(const T& _value, bool _erase) {
+	_version++;
+	if (_filter) {
+		if (_erase)
+			_filter->forget();
+		else
+			_filter->add(_avl_hash_traits<T, C>::hash(_value));
+	}
+	if (!_journaling)
 		return;
+	try {
+		_journal.push_back(avl_change<T>{ _value, _erase });
+	}
+	catch (...) {
+		_journal.clear();
+		_journal_base = _journal_floor = _version;
+	}
+}
+
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_log_reset() {
+	_version++;
+	_journal.clear();
+	_journal_base = _version;
+}
 
-	// ķʽɾ
-	_clear_tree(_current->leftChild);
-	_clear_tree(_current->rightChild);
-	delete _current;
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_journal_break() {
+	_log_reset();
+	_journal_floor = _version;
 }
 
 /*
- *	_make_copy
- *	ݸ_destС
- *	
- *	_destΪtypename avl<T, C>::_node*&ƵĿĵء
+ *	_lookup
+ *	_valueȡĽڵ㣨ĹɢʱɢбԸڵ½
+ *	˳ԱʱȲѯһڵֱֵӷؿָ룬
+ *	ĹֵѲڹУ˷ؿָ벢ʾûиֵĹ
  */
-template <typename T, typename C>
-void avl<T, C>::_make_copy(typename avl<T, C>::_node*& _dest) const {
-
-	// Ƚڵݸ_destС
-	_dest = new typename avl<T, C>::_node(_root->value);
-	_dest->factor = _root->factor;
-
-	// ٵø_copy_node
-	_copy_node(_dest, _root);
+template <typename T, typename C, typename S, typename B>
+const typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_lookup(const T& _value) const {
+	if (_filter && !_filter->may_contain(_avl_hash_traits<T, C>::hash(_value)))
+		return nullptr;
+	if (!_index)
+		return _find_node(_root, _value);
+	return _index->find(_avl_hash_traits<T, C>::hash(_value), [this, &_value](const _node* _n) {
+		this->_stat_compare();
+		return !_comparator(_value, _n->value) && !_comparator(_n->value, _value);
+	});
 }
 
 /*
- *	_copy_node
- *	ƶ
- *	
- *	_destĿĵء
- *	_srcԴ
+ *	_index_insert_index_rebuild
+ *	ڵɢ򰴵ǰ½
+ *	ڴʧʱر׳쳣֤޸ĲӰ졣
  */
-template <typename T, typename C>
-void avl<T, C>::_copy_node(typename avl<T, C>::_node* _dest, const typename avl<T, C>::_node* _src) const {
-
-	// ָЧԡǳҪ
-	if (!_src || !_dest)
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_index_insert(typename avl<T, C, S, B>::_node* _n) {
+	if (!_index)
 		return;
-
-	// src֮
-	if (_src->leftChild) {
-		_dest->leftChild = new typename avl<T, C>::_node(_src->leftChild->value);
-		_dest->leftChild->parent = _dest;
-		_dest->leftChild->factor = _src->leftChild->factor;
-		_copy_node(_dest->leftChild, _src->leftChild);
+	try {
+		_index->insert(_n, _avl_hash_traits<T, C>::hash(_n->value));
 	}
+	catch (...) {
+		_index.reset();
+	}
+}
 
-	// src֮
-	if (_src->rightChild) {
-		_dest->rightChild = new typename avl<T, C>::_node(_src->rightChild->value);
-		_dest->rightChild->parent = _dest;
-		_dest->rightChild->factor = _src->rightChild->factor;
-		_copy_node(_dest->rightChild, _src->rightChild);
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_index_rebuild() {
+	if (!_index)
+		return;
+	_index->clear();
+	if (!_root)
+		return;
+	try {
+		_index->reserve(_size + _dead);
+		const _node* _p = _root;
+		while (_p->leftChild)
+			_p = _p->leftChild;
+		for (; _p; _p = _successor(_p))
+			_index->insert(const_cast<_node*>(_p), _avl_hash_traits<T, C>::hash(_p->value));
+	}
+	catch (...) {
+		_index.reset();
 	}
 }
 
 /*
- *	_check_tree
- *	_nΪڵǷAVLĶ塣
- *	ִӦ
- *	
- *	_nΪtypename avl<T, C>::_node*Ľڵ㡣
- *	ֵtypename avl<T, C>::_node*Ľڵ㡣
+ *	_filter_rebuild_filter_maintain
+ *	_filter_rebuildǰԪȷĴСؽɾԪµλ
+ *	_filter_maintainҪʱؽɸ޸Ĳã̯ΪO(1)
+ *	еλֻƳؽֻʱʣ©κԪء
+ *	ڴʧʱرչ׳쳣֤޸ĲܹӰ졣
  */
-template <typename T, typename C>
-typename avl<T, C>::_node* avl<T, C>::_check_tree(typename avl<T, C>::_node* _n) {
-
-	// _nƽӽе
-	// еstd::terminate()֧ʾAVLĶܵķ֧
-	switch (_n->factor) {
-	case -2: {
-
-		// _nƽΪ-2ҪR-תԱAVLʡ
-		auto _prev_r = _n->rightChild;
-		auto _prev_rl = _prev_r->leftChild;
-		auto _prev_par = _n->parent;
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_filter_rebuild() {
+	if (!_filter)
+		return;
+	try {
+		_filter->reset(_size);
+	}
+	catch (...) {
+		_filter.reset();
+		return;
+	}
+	for (auto _p = _first_node(); _p; _p = _successor(_p))
+		if (!_p->dead)
+			_filter->add(_avl_hash_traits<T, C>::hash(_p->value));
+}
 
-		// תĸ߶ȼȥ1˵ڵƽӡ
-		// _insert_nodeеĵҲڴ˴ҵ𰸡
-		if (_prev_par) {
-			if (_prev_par->leftChild == _n)
-				_prev_par->factor--;
-			else
-				_prev_par->factor++;
-		}
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_filter_maintain() {
+	if (_filter && _filter->needs_rebuild(_size))
+		_filter_rebuild();
+}
 
-		// ٸƽӽе
-		// еƽӵΪֽ֤õĽ
-		// ʿԼ֤
-		switch (_prev_r->factor) {
+/*
+ *	ӿڣset_membership_filter(double, size_type)membership_filter()
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::set_membership_filter(double _fpr, size_type _max_bytes) {
+	if (!_avl_hash_traits<T, C>::enabled || _fpr <= 0) {
+		_filter.reset();
+		return false;
+	}
+	if (_fpr > 0.5)
+		_fpr = 0.5;
+	try {
+		_filter.reset(new _avl_bloom_filter(_fpr, _max_bytes));
+	}
+	catch (const std::bad_alloc&) {
+		_filter.reset();
+		return false;
+	}
+	_filter_rebuild();
+	return static_cast<bool>(_filter);
+}
 
-			// ƽΪ-1R-Rת
-		case -1:
-			_n->factor = 0;
-			_prev_r->factor = 0;
-			return _rr_rotate(_n);
+template <typename T, typename C, typename S, typename B>
+avl_filter_stats avl<T, C, S, B>::membership_filter() const {
+	avl_filter_stats _result;
+	if (_filter) {
+		_result.target_fpr = _filter->target();
+		_result.estimated_fpr = _filter->estimated_fpr();
+		_result.memory = _filter->memory();
+		_result.memory_budget = _filter->budget();
+		_result.capacity = _filter->capacity();
+		_result.stale = _filter->stale();
+	}
+	return _result;
+}
 
-			// ƽΪ0R-LתR-Rת
-			// R-RתС˴˴ѡR-Rת
-		case 0:
-			_n->factor = -1;
-			_prev_r->factor = 1;
-			return _rr_rotate(_n);
+/*
+ *	ӿڣset_capacity(size_type, avl_eviction)
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::set_capacity(size_type _capacity, avl_eviction _policy) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	_bound = _capacity;
+	_eviction = _policy;
+	_hand = nullptr;
+	_enforce_capacity(nullptr);
+}
 
-			// ƽΪ1R-Lת
-		case 1:
-			switch (_prev_rl->factor) {
-			case -1:
-				_n->factor = 1;
-				_prev_r->factor = _prev_rl->factor = 0;
-				break;
-			case 0:
-				_prev_r->factor = _prev_rl->factor = _n->factor = 0;
-				break;
-			case 1:
-				_prev_r->factor = _n->factor = 0;
-				_prev_rl->factor = 1;
-				break;
-			default:
-				std::terminate();
-			}
-			return _rl_rotate(_n);
-		default:
-			std::terminate();
-		}
+/*
+ *	_enforce_capacity
+ *	ģʽ£̭ɾԪأֱԪظ
+ *	̭СԪʱȡһˣĹ_clock_victimѡ
+ *	
+ *	_keepղĽڵ㣬LRṶʱѡΪա
+ *	ֵbool_keepǷ̭
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::_enforce_capacity(const _node* _keep) {
+	bool _evicted = false;
+	while (_bound && _size > _bound) {
+		_node* _victim;
+		if (_eviction == avl_evict_smallest)
+			_victim = const_cast<_node*>(_first_node());
+		else if (_eviction == avl_evict_largest)
+			_victim = const_cast<_node*>(_last_node());
+		else
+			_victim = _clock_victim(_keep);
+		if (_victim == _keep)
+			_evicted = true;
+		_remove_node(_victim);
+		_evictions++;
 	}
+	return _evicted;
+}
 
-		   // ƽӵľֵСڵ1õ_nɡ
-	case -1:
-	case 0:
-	case 1:
-		return _n;
-
-		// ƽӵ2ҪL-ת
-		// ˲R-תΪϷcase -2Ķ
-	case 2: {
-		auto _prev_l = _n->leftChild;
-		auto _prev_lr = _prev_l->rightChild;
-		auto _prev_par = _n->parent;
-		if (_prev_par) {
-			if (_prev_par->leftChild == _n)
-				_prev_par->factor--;
-			else
-				_prev_par->factor++;
-		}
-		switch (_prev_l->factor) {
-		case 1:
-			_prev_l->factor = _n->factor = 0;
-			return _ll_rotate(_n);
-		case 0:
-			_prev_l->factor = -1;
-			_n->factor = 1;
-			return _ll_rotate(_n);
-		case -1:
-			switch (_prev_lr->factor) {
-			case -1:
-				_prev_l->factor = 1;
-				_prev_lr->factor = _n->factor = 0;
-				break;
-			case 0:
-				_prev_l->factor = _prev_lr->factor = _n->factor = 0;
-				break;
-			case 1:
-				_prev_l->factor = _prev_lr->factor = 0;
-				_n->factor = -1;
-				break;
-			default:
-				std::terminate();
-			}
-			return _lr_rotate(_n);
-		default:
-			break;
+/*
+ *	_clock_victim
+ *	_handʼɨ裨ĩβصĽڵ㣩Ĺ_keep
+ *	λΪ1ĽڵλصһλΪ0Ľڵ㣻
+ *	_clock_scanλֱ֮ӷһ̭Ľڵ㡣
+ *	_handָѡнڵḷ́һ̭
+ *	֤߱г_keepٻһԪء
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_clock_victim(const _node* _keep) {
+	const _node* _p = _hand ? _hand : _leftmost;
+	for (std::size_t _cleared = 0;; ) {
+		if (!_p->dead && _p != _keep) {
+			if (!_p->referenced || _cleared >= _clock_scan)
+				break;
+			_p->referenced = false;
+			_cleared++;
 		}
+		_p = _successor(_p);
+		if (!_p)
+			_p = _leftmost;
 	}
-	default:
-		break;
+	_hand = const_cast<_node*>(_successor(_p));
+	return const_cast<_node*>(_p);
+}
+
+/*
+ *	ӿڣset_hash_index(double)
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::set_hash_index(double _max_load) {
+	if (!_avl_hash_traits<T, C>::enabled || _max_load <= 0) {
+		_index.reset();
+		return false;
 	}
-	std::terminate();
-	return nullptr;
+	if (_max_load > 0.9)
+		_max_load = 0.9;
+	try {
+		_index.reset(new _avl_hash_index<_node>(_max_load));
+	}
+	catch (const std::bad_alloc&) {
+		_index.reset();
+		return false;
+	}
+	_index_rebuild();
+	return static_cast<bool>(_index);
 }
 
 /*
- *	_ll_rotate
- *	ָĽڵִL-Lת
+ *	ӿڣtruncate_journal(std::uint64_t)
+ *	ʹ汾Ų_uptoļ¼ͨи߶׷_uptoã
+ *	˺journal_floor()С_upto_uptoǰ汾ʱΪǰ汾
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::truncate_journal(std::uint64_t _upto) {
+	if (_upto > _version)
+		_upto = _version;
+	if (_upto <= _journal_floor)
+		return;
+	if (_upto > _journal_base) {
+		_journal.erase(_journal.begin(), _journal.begin() + static_cast<std::ptrdiff_t>(_upto - _journal_base));
+		_journal_base = _upto;
+	}
+	_journal_floor = _upto;
+}
+
+/*
+ *	ӿڣdelta_since(std::uint64_t, avl_delta<T>&)
+ *	ɴӰ汾_sinceǰ汾ȡļ¼Ƚȶ
+ *	ͬһֵֻһ޸ġʱO(k log k)kΪļ¼ĴС޹ء
  *	
- *	_nĽڵ㡣
+ *	_sinceߵǰİ汾
+ *	_out
+ *	ֵbool_sincejournal_floor()ڵǰ汾δ־
+ *	޷falseҪơ
  */
-template <typename T, typename C>
-typename avl<T, C>::_node* avl<T, C>::_ll_rotate(typename avl<T, C>::_node* _n) {
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::delta_since(std::uint64_t _since, avl_delta<T>& _out) const {
+	if (!_journaling || _since < _journal_floor || _since > _version)
+		return false;
+	_out.reset = _since < _journal_base;
+	_out.changes.assign(_journal.begin() + static_cast<std::ptrdiff_t>(_out.reset ? 0 : _since - _journal_base), _journal.end());
+	_avl_merge_changes(_out.changes, _comparator);
+	return true;
+}
 
-	// ĶĴʱʺֽ߶߶
-	// ¼_nĸڵ
-	auto _prev_parent = _n->parent;
-	auto _prev_left = _n->leftChild;
+/*
+ *	ӿڣapply_delta(const avl_delta<T>&)
+ *	delta_sinceɵӦõҪʱգνremove_sortedput_sortedɾ롣
+ *	е޸Ѱֵ˺ʱΪO(k log n)O(n + k)нСߡ
+ *	İ汾־ճ޸ĸ£뱻İ汾޹ء
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::apply_delta(const avl_delta<T>& _delta) {
+	if (_delta.reset)
+		clear();
+	std::vector<std::reference_wrapper<const T>> _puts, _erases;
+	for (auto& _c : _delta.changes)
+		(_c.erase ? _erases : _puts).push_back(std::cref(_c.value));
+	remove_sorted(_erases.begin(), _erases.end());
+	put_sorted(_puts.begin(), _puts.end());
+}
 
-	// _prev_leftĸڵΪ_prev_parent
-	_prev_left->parent = _prev_parent;
-	if (_prev_parent) {
-		if (_prev_parent->rightChild == _n) {
-			_prev_parent->rightChild = _prev_left;
-		}
-		else {
-			_prev_parent->leftChild = _prev_left;
-		}
+/*
+ *	ӿڣpop_front()pop_back()
+ *	ɾС󣩵ԪأңʺϽAVLȶС
+ *	ңĽڵһӽڵ㣬ժֻ趥ϻݡ
+ *	ɾģʽҲֱɾڵ㣬˳λһ˵Ĺ
+ *	ʹfront()back()ΪO(1)
+ *	ֵboolΪʱfalse
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::pop_front() {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	while (_leftmost && _leftmost->dead) {
+		auto _n = _leftmost;
+		_unlink_node(_n);
+		_delete_node(_n);
+		_dead--;
+	}
+	if (!_leftmost)
+		return false;
+	this->_stat_op_begin(avl_op_remove);
+	this->_stat_op_end();
+	_remove_node(_leftmost);
+	return true;
+}
+
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::pop_back() {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	while (_rightmost && _rightmost->dead) {
+		auto _n = _rightmost;
+		_unlink_node(_n);
+		_delete_node(_n);
+		_dead--;
 	}
+	if (!_rightmost)
+		return false;
+	this->_stat_op_begin(avl_op_remove);
+	this->_stat_op_end();
+	_remove_node(_rightmost);
+	return true;
+}
+
+/*
+ *	ӿڣerase(const_iterator)
+ *	ɾָԪأٴβҡ
+ *	
+ *	_posָɾԪصЧβ
+ *	ֵiteratorָɾԪصĺ̡
+ *	ָɾԪصĵ⣬ȻЧ
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::erase(typename avl<T, C, S, B>::const_iterator _pos) {
+	if (_graves)
+		reclaim(_reclaim_slice);
+	_filter_maintain();
+	auto _next = _pos;
+	++_next;
+	this->_stat_op_begin(avl_op_remove);
+	this->_stat_op_end();
+	if (_lazy)
+		_bury_node(const_cast<_node*>(_pos._value));
 	else
-		_root = _prev_left;
+		_remove_node(const_cast<_node*>(_pos._value));
+	return _next;
+}
 
-	// _nΪ_prev_left
-	_n->leftChild = _prev_left->rightChild;
-	if (_prev_left->rightChild)
-		_prev_left->rightChild->parent = _n;
+/*
+ *	ӿڣerase(const_iterator, const_iterator)
+ *	ɾ[_first, _last)еԪء
+ *	϶ʱɾ_first_lastָ
+ *	ͷмһΣٽϲʱΪO(k + (log n)^2)kΪɾԪظ
+ *	ֵiterator_last
+ */
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::erase(typename avl<T, C, S, B>::const_iterator _first,
+	typename avl<T, C, S, B>::const_iterator _last) {
+	if (_first == _last)
+		return _last;
+	_filter_maintain();
+
+	// ߵɱʱɾ㡣
+	// ɾģʽɾֻĹǸ㡣
+	// ָϲƽӣȵƽҲɾ
+	std::size_t _h = _height(_root);
+	std::size_t _limit = 2 * _h;
+	std::size_t _count = 0;
+	for (auto _it = _first; _it != _last && _count < _limit; ++_it)
+		_count++;
+	if (_count < _limit || _lazy || B::ranked) {
+		while (_first != _last)
+			_first = erase(_first);
+		return _last;
+	}
 
-	// _prev_leftΪ_n
-	_n->parent = _prev_left;
-	_prev_left->rightChild = _n;
+	// ָϲڵĹ_first_lastָĽڵ㲻Ӱ졣
+	// ѹؽ֮¼ߡ
+	if (_dead) {
+		compact();
+		_h = _height(_root);
+	}
 
-	// _prev_leftΪɵĽڵ㡣
-	return _prev_left;
+	this->_stat_op_begin(avl_op_remove);
+	_node* _left;
+	_node* _mid;
+	_node* _right;
+	std::size_t _lh, _mh, _rh;
+
+	// _firstָٽҲĲ_lastָ
+	_split(_root, _h, _first._value->value, _left, _lh, _mid, _mh);
+	if (_last._value)
+		_split(_mid, _mh, _last._value->value, _mid, _mh, _right, _rh);
+	else {
+		_right = nullptr;
+		_rh = 0;
+	}
+	this->_stat_op_end();
+
+	// ͷмһΣٺϲࡣ
+	_size -= _free_subtree(_mid);
+	_root = _join(_left, _lh, _right, _rh, _h);
+	_reset_extremes();
+	return _last;
 }
 
 /*
- *	_rr_rotate
- *	ָĽڵʵR-Rת
+ *	ӿڣerase_if(P)
+ *	ɾν_predԪأνʶÿԪǡõһΡ
+ *	ɾԪؽʱɾɾĴklog(n)nʱ
+ *	ΪµĽڵO(n)ʱ´һȫƽ
  *	
- *	_nĽڵ㡣
+ *	_predconst T&boolνʡ
+ *	ֵsize_typeɾԪظ
  */
-template <typename T, typename C>
-typename avl<T, C>::_node* avl<T, C>::_rr_rotate(typename avl<T, C>::_node* _n) {
+template <typename T, typename C, typename S, typename B>
+template <typename P>
+typename avl<T, C, S, B>::size_type avl<T, C, S, B>::erase_if(P _pred) {
+	_filter_maintain();
+
+	// һ飺ռɾĽڵ㡣ʱδ޸ν׳쳣Ҳƻݡ
+	std::vector<_node*> _drop;
+	for (auto _it = cbegin(); _it != cend(); ++_it)
+		if (_pred(*_it))
+			_drop.push_back(const_cast<_node*>(_it._value));
+	if (_drop.empty())
+		return 0;
+
+	// °ڵĹ
+	if (_dead)
+		compact();
+
+	if (_drop.size() * _height(_root) < _size) {
+		for (auto _n : _drop)
+			_remove_node(_n);
+		return _drop.size();
+	}
 
-	// R-RתL-LתΪοL-LתԴĶ
-	auto _prev_parent = _n->parent;
-	auto _prev_right = _n->rightChild;
-	_prev_right->parent = _prev_parent;
-	if (_prev_parent) {
-		if (_prev_parent->rightChild == _n) {
-			_prev_parent->rightChild = _prev_right;
-		}
-		else {
-			_prev_parent->leftChild = _prev_right;
-		}
+	// ڶ飺ռµĽڵ㡣ɾĽڵҲУֻαȶԡ
+	std::vector<_node*> _keep;
+	_keep.reserve(_size - _drop.size());
+	std::size_t _i = 0;
+	for (auto _it = cbegin(); _it != cend(); ++_it) {
+		auto _n = const_cast<_node*>(_it._value);
+		if (_i < _drop.size() && _drop[_i] == _n)
+			_i++;
+		else
+			_keep.push_back(_n);
 	}
-	else
-		_root = _prev_right;
-	_n->rightChild = _prev_right->leftChild;
-	if (_prev_right->leftChild)
-		_prev_right->leftChild->parent = _n;
-	_n->parent = _prev_right;
-	_prev_right->leftChild = _n;
-	return _prev_right;
+	for (auto _n : _drop) {
+		_log(_n->value, true);
+		_delete_node(_n);
+	}
+	std::size_t _h;
+	_root = _build_tree(_keep.data(), _keep.size(), _h);
+	_reset_extremes();
+	_size = _keep.size();
+	_debt = 0;
+	return _drop.size();
 }
 
 /*
- *	_lr_rotate
- *	ָĽڵִL-Rת
- *	
- *	_nĽڵ㡣
+ *	ӿڣclear()
+ *	ãAVL洢нڵ㲢ͷڴ档
  */
-template <typename T, typename C>
-typename avl<T, C>::_node* avl<T, C>::_lr_rotate(typename avl<T, C>::_node* _n) {
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::clear() {
+	this->_stat_free(_size + _dead);
+	// ʱֽڵλרõĽڵУȽ䲢_pool
+	_defrag_abort();
+
+	// յģʽ£O(1)Ĵ۽ͬڵһժ¡
+	// ޷Ϊ˷ڴ棬˻صա
+	bool _detached = false;
+	if (_root && _reclaim != avl_reclaim_immediate) {
+		try {
+			if (_reclaim == avl_reclaim_background) {
+				std::unique_ptr<_reclaim_task> _task(new _reclaim_task(_root));
+				_task->pool.swap(_pool);
+				_avl_reclaimer::submit(std::move(_task));
+			}
+			else {
+				auto _g = new _grave{ _root, _avl_node_pool<_node>(), _graves };
+				_g->pool.swap(_pool);
+				_graves = _g;
+			}
+			_detached = true;
+		}
+		catch (...) {
+		}
+	}
 
-	// _nִR-Rת
-	_rr_rotate(_n->leftChild);
+	// գٽڵеڴ黹ϵͳ
+	// Tƽֻ黹ڴ飬ʱڵ޹ء
+	if (!_detached) {
+		std::size_t _budget = _size + _dead;
+		_destroy_nodes(_root, _budget);
+		_pool.release();
+	}
 
-	// ٶ_nִL-Lת
-	return _ll_rotate(_n);
+	// øڵΪnullptr_sizeΪ0
+	// ʱAVLвκݡ
+	_root = nullptr;
+	_size = 0;
+	_dead = 0;
+	_debt = 0;
+	_leftmost = _rightmost = nullptr;
+	_hand = nullptr;
+	if (_index)
+		_index->clear();
+	if (_filter)
+		_filter->clear();
+	_log_reset();
 }
 
-
 /*
- *	_rl_rotate
- *	ָĽڵִR-Lת
- *	
- *	_nĽڵ㡣
+ *	ӿڣcompact()
+ *	ɾµĹռڵ㣬
+ *	ͷĹO(n)Ĵ۴һȫƽ
+ *	ڵĵַ䣬ָǵĵȻЧ
  */
-template <typename T, typename C>
-typename avl<T, C>::_node* avl<T, C>::_rl_rotate(typename avl<T, C>::_node* _n) {
-
-	// _nִL-Lת
-	_ll_rotate(_n->rightChild);
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::compact() {
+	if (!_dead)
+		return;
+	std::vector<_node*> _keep;
+	_keep.reserve(_size);
+	std::vector<_node*> _drop;
+	_drop.reserve(_dead);
+	const _node* _p = _root;
+	while (_p->leftChild)
+		_p = _p->leftChild;
+	for (; _p; _p = _successor(_p))
+		(_p->dead ? _drop : _keep).push_back(const_cast<_node*>(_p));
+	for (auto _n : _drop)
+		_delete_node(_n);
+	std::size_t _h;
+	_root = _build_tree(_keep.data(), _keep.size(), _h);
+	_reset_extremes();
+	_dead = 0;
+	_debt = 0;
+}
 
-	// ٶ_nִR-Rת
-	return _rr_rotate(_n);
+/*
+ *	_rebuild
+ *	ռнڵ㣨ĹؽΪȫƽ
+ *	ڵĵַ䣬ָǵĵȻЧ
+ *	ɾԶã޷Ϊ˷ڴݲؽһɾʱԡ
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_rebuild() {
+	std::vector<_node*> _nodes;
+	try {
+		_nodes.reserve(_size + _dead);
+	}
+	catch (const std::bad_alloc&) {
+		return;
+	}
+	if (_root) {
+		const _node* _p = _root;
+		while (_p->leftChild)
+			_p = _p->leftChild;
+		for (; _p; _p = _successor(_p))
+			_nodes.push_back(const_cast<_node*>(_p));
+	}
+	std::size_t _h;
+	_root = _build_tree(_nodes.data(), _nodes.size(), _h);
+	_reset_extremes();
+	_debt = 0;
 }
 
 /*
- *	ӿڣput
- *	һֵAVL
- *	
- *	_valueΪconst T&ֵ
+ *	ӿڣrebalance()
  */
-template <typename T, typename C>
-void avl<T, C>::put(const T& _value) {
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::rebalance() {
+	if (_dead)
+		compact();
+	else
+		_rebuild();
+}
 
-	// _rootʼ롣
-	_insert_node(_root, _value);
+/*
+ *	ӿڣrelayout(avl_layout)
+ *	Ȱָ˳ռнڵ㣬һµĽڵθƣ
+ *	ȫɹ֮޸TĿ׳쳣ʱֲ䡣
+ *	ڼþɽڵparentֶμ¼丱ݴӸ֮ĸӹϵ
+ */
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::relayout(avl_layout _order) {
+	_defrag_abort();
+	if (!_root)
+		return;
+	std::vector<_node*> _old;
+	_old.reserve(_size + _dead);
+	if (_order == avl_layout_veb)
+		_veb_order(_root, _height(_root), _old);
+	else
+		for (auto _p = _leftmost; _p; _p = const_cast<_node*>(_successor(_p)))
+			_old.push_back(_p);
+
+	_avl_node_pool<_node> _fresh;
+	_fresh.reserve(_old.size());
+	std::vector<_node*> _copies;
+	_copies.reserve(_old.size());
+	try {
+		for (auto _n : _old)
+			_copies.push_back(_construct_node(_fresh, _n->value));
+	}
+	catch (...) {
+		for (auto _n : _copies)
+			_n->~_node();
+		throw;
+	}
 
-	// _insert_nodeδ_rootк飬Ժڴ˴С
-	_root = _check_tree(_root);
+	for (std::size_t _i = 0; _i < _old.size(); _i++) {
+		_copies[_i]->factor = _old[_i]->factor;
+		_copies[_i]->dead = _old[_i]->dead;
+		_copies[_i]->referenced = _old[_i]->referenced;
+		_old[_i]->parent = _copies[_i];
+	}
+	for (std::size_t _i = 0; _i < _old.size(); _i++) {
+		auto _n = _copies[_i];
+		if (_old[_i]->leftChild) {
+			_n->leftChild = _old[_i]->leftChild->parent;
+			_n->leftChild->parent = _n;
+		}
+		if (_old[_i]->rightChild) {
+			_n->rightChild = _old[_i]->rightChild->parent;
+			_n->rightChild->parent = _n;
+		}
+	}
+	_root = _root->parent;
+	_root->parent = nullptr;
+	_leftmost = _leftmost->parent;
+	_rightmost = _rightmost->parent;
+	if (_hand)
+		_hand = _hand->parent;
+
+	for (auto _n : _old)
+		_n->~_node();
+	this->_stat_alloc(_old.size());
+	this->_stat_free(_old.size());
+	// ɽڵûκνڵ㣬_freshһͬͷš
+	_pool.swap(_fresh);
+	_index_rebuild();
 }
 
 /*
- *	ӿ:find
- *	һֵǷλAVLС
- *	
- *	_valueΪconst T&ҵֵ
- *	ֵboolʾǷҵ
+ *	_veb_order_veb_bottom
+ *	_veb_ordervan Emde Boas˳ռ_nΪС_levelsĽڵ㣺
+ *	ȵݹռ_levels / 2㣬ٶµĸֱݹ顣
+ *	_veb_bottom_n֮ǡΪ_depthĸڵ㣬ҵ_levels_veb_order
+ *	ݹΪO(log n)
  */
-template <typename T, typename C>
-bool avl<T, C>::find(const T& _value) const {
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_veb_order(_node* _n, std::size_t _levels, std::vector<_node*>& _out) {
+	if (!_n || !_levels)
+		return;
+	if (_levels == 1) {
+		_out.push_back(_n);
+		return;
+	}
+	std::size_t _top = _levels / 2;
+	_veb_order(_n, _top, _out);
+	_veb_bottom(_n, _top, _levels - _top, _out);
+}
 
-	// ʵʹ_find_node_rootʼҡ
-	// ҵĽڵΪָ룬ûҵ
-	// ҵĽڵǿգҵ
-	return static_cast<bool>(_find_node(_root, _value));
+template <typename T, typename C, typename S, typename B>
+void avl<T, C, S, B>::_veb_bottom(_node* _n, std::size_t _depth, std::size_t _levels, std::vector<_node*>& _out) {
+	if (!_n)
+		return;
+	if (!_depth) {
+		_veb_order(_n, _levels, _out);
+		return;
+	}
+	_veb_bottom(_n->leftChild, _depth - 1, _levels, _out);
+	_veb_bottom(_n->rightChild, _depth - 1, _levels, _out);
 }
 
 /*
- *	ӿڣremove
- *	ɾһֵֵλAVLС
- *	
- *	_valueΪconst T&ɾֵ
- *	ֵ
- *	boolָʾɾǷɹִС
+ *	_transplant
+ *	ڵ_oldƵרýڵصǰڴһڵУ
+ *	½ڵ_oldеλãƽϢĹɢͷ_old
+ *	TĿ׳쳣ֲ䡣
+ *	ֵtypename avl<T, C, S, B>::_node*½ڵ㡣
  */
-template <typename T, typename C>
-bool avl<T, C>::remove(const T& _value) {
-
-	// ȲҽڵǷAVLС
-	auto _loc_node = const_cast<typename avl<T, C>::_node*>(_find_node(_root, _value));
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::_node* avl<T, C, S, B>::_transplant(_node* _old) {
+	void* _p = _defrag_pool.allocate_sequential();
+	_node* _n;
+	try {
+		_n = ::new (_p) _node(_old->value);
+	}
+	catch (...) {
+		_defrag_pool.deallocate(_p);
+		throw;
+	}
+	this->_stat_alloc(1);
+	_defrag_live++;
+	_n->factor = _old->factor;
+	_n->dead = _old->dead;
+	_n->referenced = _old->referenced;
+	_n->leftChild = _old->leftChild;
+	_n->rightChild = _old->rightChild;
+	_n->parent = _old->parent;
+	if (_n->leftChild)
+		_n->leftChild->parent = _n;
+	if (_n->rightChild)
+		_n->rightChild->parent = _n;
+	if (!_n->parent)
+		_root = _n;
+	else if (_is_left_child(_n->parent, _old))
+		_n->parent->leftChild = _n;
+	else
+		_n->parent->rightChild = _n;
+	if (_leftmost == _old)
+		_leftmost = _n;
+	if (_rightmost == _old)
+		_rightmost = _n;
+	if (_hand == _old)
+		_hand = _n;
+	_delete_node(_old);
+	_index_insert(_n);
+	return _n;
+}
 
-	// _loc_nodeǿգ˽ڵAVLС
-	if (_loc_node) {
+/*
+ *	ӿڣdefragment(size_type)
+ *	ÿʼʱרõĽڵ_defrag_poolΪнڵԤһڴ飬
+ *	֮ÿεôϴͣµֵ֮󣨰Ƚ˳򣩼
+ *	в_defrag_poolеĽڵƵڴУĽڵͬ_budget
+ *	ͣµλֵǽڵ¼ε֮޸ĶʹʧЧ
+ *	һʱнڵ㶼λ_defrag_poolУȡ_poolͷԭȫڴ飻
+ *	򣨱Ԫز뵽Ĳ֣ͷһ飬ֻЩڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+bool avl<T, C, S, B>::defragment(size_type _budget) {
+	if (!_defragging) {
+		if (!_root)
+			return false;
+		_defrag_pool.reserve(_size + _dead);
+		_defragging = true;
+		_defrag_cursor.reset();
+		_defrag_live = 0;
+	}
 
-		// _remove_nodeɾڵ㣬trueʾɹɾ
-		_remove_node(_loc_node);
-		return true;
+	// λһڡ_defrag_cursorĽڵ㣨Ĺ
+	_node* _n = _leftmost;
+	if (_defrag_cursor) {
+		_n = nullptr;
+		for (auto _p = _root; _p;) {
+			if (_compare(*_defrag_cursor, _p->value) < 0) {
+				_n = _p;
+				_p = _p->leftChild;
+			}
+			else
+				_p = _p->rightChild;
+		}
 	}
-	else {
 
-		// δҵڵ㣬falseʾɾʧܡ
+	_node* _last = nullptr;
+	for (; _n && _budget; _budget--) {
+		_last = _defrag_pool.owns(_n) ? _n : _transplant(_n);
+		_n = const_cast<_node*>(_successor(_last));
+	}
+	if (!_n) {
+		_defrag_cursor.reset();
+		if (_defrag_live < _size + _dead)
+			return true;
+		// ԭڵûκνڵ㣬һͬͷš
+		_pool.swap(_defrag_pool);
+		_defrag_pool.release();
+		_defragging = false;
 		return false;
 	}
+	if (_last)
+		_defrag_cursor.reset(new T(_last->value));
+	return true;
 }
 
 /*
- *	ӿڣclear()
- *	ãAVL洢нڵ㲢ͷڴ档
+ *	ӿڣlocality()
+ *	ͳڵĽڵ븸ӽڵֲԵı
+ *	вڵʱΪ1
  */
-template <typename T, typename C>
-void avl<T, C>::clear() {
-
-	// _clear_treeɾ
-	_clear_tree(_root);
+template <typename T, typename C, typename S, typename B>
+avl_locality avl<T, C, S, B>::locality() const {
+	avl_locality _result;
+	if (!_root || (_root == _leftmost && _root == _rightmost))
+		return _result;
+	constexpr std::uintptr_t _page = 4096;
+	const std::uintptr_t _slot = _avl_node_pool<_node>::slot_size();
+	std::size_t _pairs = 0, _adjacent = 0;
+	std::size_t _edges = 0, _near = 0;
+	const _node* _prev = nullptr;
+	for (const _node* _p = _leftmost; _p; _p = _successor(_p)) {
+		auto _a = reinterpret_cast<std::uintptr_t>(_p);
+		if (_prev) {
+			auto _b = reinterpret_cast<std::uintptr_t>(_prev);
+			_pairs++;
+			if ((_a > _b ? _a - _b : _b - _a) <= _slot)
+				_adjacent++;
+		}
+		if (_p->parent) {
+			_edges++;
+			if (_a / _page == reinterpret_cast<std::uintptr_t>(_p->parent) / _page)
+				_near++;
+		}
+		_prev = _p;
+	}
+	_result.sequential = static_cast<double>(_adjacent) / static_cast<double>(_pairs);
+	_result.descent = static_cast<double>(_near) / static_cast<double>(_edges);
+	return _result;
+}
 
-	// øڵΪnullptr_sizeΪ0
-	// ʱAVLвκݡ
-	_root = nullptr;
-	_size = 0;
+/*
+ *	ӿڣstats()
+ *	һڲͳݵĿա
+ *	ͳƲSṩδͳʱΪ0
+ *	߶Ƚƽؽϸߵһ½ãʱO(log n)
+ *	ƽֱͼҪʱO(n)˹Ƶصá
+ *	ȵƽ²¼ƽӣ߶ͨãֱͼΪա
+ *	ֵavl_stats_snapshotͳݵĿա
+ */
+template <typename T, typename C, typename S, typename B>
+avl_stats_snapshot avl<T, C, S, B>::stats() const {
+	avl_stats_snapshot _snap;
+	this->_stat_fill(_snap);
+	_snap.size = _size;
+	_snap.tombstones = _dead;
+	_snap.height = 0;
+	for (std::size_t _i = 0; _i < 3; _i++)
+		_snap.factor_histogram[_i] = 0;
+	if (B::ranked) {
+		// ͬʱάǰڵȡ
+		const _node* _p = _root;
+		std::size_t _depth = 1;
+		if (_p)
+			for (; _p->leftChild; _depth++)
+				_p = _p->leftChild;
+		while (_p) {
+			if (_depth > _snap.height)
+				_snap.height = _depth;
+			if (_p->rightChild) {
+				_p = _p->rightChild;
+				for (_depth++; _p->leftChild; _depth++)
+					_p = _p->leftChild;
+			}
+			else {
+				while (_p->parent && _p->parent->rightChild == _p) {
+					_p = _p->parent;
+					_depth--;
+				}
+				_p = _p->parent;
+				_depth--;
+			}
+		}
+		return _snap;
+	}
+	for (auto _p = _root; _p; _p = _p->factor < 0 ? _p->rightChild : _p->leftChild)
+		_snap.height++;
+	if (_root) {
+		const _node* _p = _root;
+		while (_p->leftChild)
+			_p = _p->leftChild;
+		for (; _p; _p = _successor(_p))
+			_snap.factor_histogram[_p->factor + 1]++;
+	}
+	return _snap;
 }
 
 /*
  *	ӿ壺beginϵСendϵС
  *	AVL׵β
  */
-template <typename T, typename C>
-typename avl<T, C>::iterator avl<T, C>::begin() {
-	auto _p = _root;
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::begin() {
 
-	// ظڵ·ֱ
-	// ʱĽڵAVL׽ڵ㡣
-	if (_p)
-		while (_p->leftChild)
-			_p = _p->leftChild;
-	return _avl_iterator<T, C>(this, _p);
+	// ظڵ·ֱ
+	// ܴڵĹʱĽڵAVL׽ڵ㡣
+	return _avl_iterator<T, C, S, B>(this, _first_node());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::iterator avl<T, C>::end() {
-	return _avl_iterator<T, C>(this, nullptr);
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::end() {
+	return _avl_iterator<T, C, S, B>(this, nullptr);
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_iterator avl<T, C>::begin() const {
-	auto _p = _root;
-	if (_p)
-		while (_p->leftChild)
-			_p = _p->leftChild;
-	return _avl_iterator<T, C>(this, _p);
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::begin() const {
+	return _avl_iterator<T, C, S, B>(this, _first_node());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_iterator avl<T, C>::end() const {
-	return _avl_iterator<T, C>(this, nullptr);
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::end() const {
+	return _avl_iterator<T, C, S, B>(this, nullptr);
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_iterator avl<T, C>::cbegin() const {
-	auto _p = _root;
-	if (_p)
-		while (_p->leftChild)
-			_p = _p->leftChild;
-	return _avl_iterator<T, C>(this, _p);
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_iterator avl<T, C, S, B>::cbegin() const {
+	return _avl_iterator<T, C, S, B>(this, _first_node());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::iterator avl<T, C>::cend() const {
-	return _avl_iterator<T, C>(this, nullptr);
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::iterator avl<T, C, S, B>::cend() const {
+	return _avl_iterator<T, C, S, B>(this, nullptr);
 }
 
 /*
@@ -1172,38 +5120,38 @@ typename avl<T, C>::iterator avl<T, C>::cend() const {
  *	شAVLķ
  *	ɲμreverse_iterator˵
  */
-template <typename T, typename C>
-typename avl<T, C>::reverse_iterator
-avl<T, C>::rbegin() {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::reverse_iterator
+avl<T, C, S, B>::rbegin() {
 	return std::make_reverse_iterator(end());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::reverse_iterator
-avl<T, C>::rend() {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::reverse_iterator
+avl<T, C, S, B>::rend() {
 	return std::make_reverse_iterator(begin());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_reverse_iterator
-avl<T, C>::rbegin() const {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_reverse_iterator
+avl<T, C, S, B>::rbegin() const {
 	return std::make_reverse_iterator(cend());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_reverse_iterator
-avl<T, C>::rend() const {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_reverse_iterator
+avl<T, C, S, B>::rend() const {
 	return std::make_reverse_iterator(cbegin());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_reverse_iterator
-avl<T, C>::crbegin() const {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_reverse_iterator
+avl<T, C, S, B>::crbegin() const {
 	return std::make_reverse_iterator(cend());
 }
 
-template <typename T, typename C>
-typename avl<T, C>::const_reverse_iterator
-avl<T, C>::crend() const {
+template <typename T, typename C, typename S, typename B>
+typename avl<T, C, S, B>::const_reverse_iterator
+avl<T, C, S, B>::crend() const {
 	return std::make_reverse_iterator(cbegin());
 }
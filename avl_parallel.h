@@ -0,0 +1,473 @@
+/*
+	avl_parallel.hAVLĲбԼ
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* ṩparallel_for_eachparallel_reduceparallel_transform_reduce
+* ڸ㻮Ϊ̳߳أɵǰ̼߳
+* AVLĸ߶ΪO(log n)ֵĴС˻ִۺСҽΪ⡣
+* ̳߳زùȡÿ߳ȴԼµ񣬿ʱȡ
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * class _avl_task_groupһfork-join
+ * ¼δɵԼ׳ĵһ쳣
+ */
+class _avl_task_group {
+private:
+	friend class _avl_work_pool;
+	std::atomic<std::size_t> _pending{ 0 };
+	std::mutex _mutex;
+	std::exception_ptr _error;
+};
+
+/*
+ * class _avl_work_poolΨһĹȡ̳߳ء
+ * ̳߳ڵһʹʱ߳ΪӲ
+ * ÿ߳һУһн̵߳
+ * ȴɵ̲߳ǰæִжеǶ׵ȴ
+ * ̳߳˳Ժ󣨻޷߳ʱڵֱִ߳С
+ */
+class _avl_work_pool {
+private:
+	/*
+	 * ݽṹ_queue
+	 * һ̵߳Сߴβȡȡߴͷȡ
+	 */
+	struct _queue {
+		std::mutex mutex;
+		std::deque<std::pair<std::function<void()>, _avl_task_group*>> tasks;
+	};
+
+	// ̵߳УһнԹ߳
+	std::vector<std::unique_ptr<_queue>> _queues;
+	std::vector<std::thread> _workers;
+	// же߳жǷҪȴ
+	std::atomic<std::size_t> _queued{ 0 };
+	std::mutex _sleep;
+	std::condition_variable _wake;
+	bool _stop = false;
+
+	// ̳߳ǷѾ˳ʹƽ֤ͣھ̬֮Կɶȡ
+	static bool& _shut_down() {
+		static bool _flag = false;
+		return _flag;
+	}
+
+	// ǰ̳߳߳еıţǹ߳ʱΪ1У
+	static std::size_t& _home() {
+		static thread_local std::size_t _index = static_cast<std::size_t>(-1);
+		return _index;
+	}
+
+	static _avl_work_pool& _instance() {
+		static _avl_work_pool _pool;
+		return _pool;
+	}
+
+	_avl_work_pool() {
+		std::size_t _n = std::thread::hardware_concurrency();
+		if (!_n)
+			_n = 1;
+		for (std::size_t _i = 0; _i <= _n; _i++)
+			_queues.emplace_back(new _queue);
+		try {
+			for (std::size_t _i = 0; _i < _n; _i++)
+				_workers.emplace_back([this, _i]() {
+					_home() = _i;
+					_loop(_i);
+				});
+		}
+		catch (...) {
+			if (_workers.empty())
+				_stop = true;
+		}
+	}
+
+	~_avl_work_pool() {
+		{
+			std::lock_guard<std::mutex> _lock(_sleep);
+			_stop = true;
+		}
+		_wake.notify_all();
+		for (auto& _t : _workers)
+			_t.join();
+		_shut_down() = true;
+	}
+
+	// ǰ߳ӦʹõĶ±ꡣ
+	std::size_t _self() const {
+		std::size_t _i = _home();
+		return _i < _queues.size() ? _i : _queues.size() - 1;
+	}
+
+	/*
+	 * _run_one
+	 * ȴ_homeŶеβȡδеͷȡȡִ֮
+	 * ֵboolָʾǷִ
+	 */
+	bool _run_one(std::size_t _home_index) {
+		std::pair<std::function<void()>, _avl_task_group*> _task;
+		bool _found = false;
+		for (std::size_t _k = 0; _k < _queues.size() && !_found; _k++) {
+			std::size_t _i = (_home_index + _k) % _queues.size();
+			auto& _q = *_queues[_i];
+			std::lock_guard<std::mutex> _lock(_q.mutex);
+			if (_q.tasks.empty())
+				continue;
+			if (_k == 0) {
+				_task = std::move(_q.tasks.back());
+				_q.tasks.pop_back();
+			}
+			else {
+				_task = std::move(_q.tasks.front());
+				_q.tasks.pop_front();
+			}
+			_found = true;
+		}
+		if (!_found)
+			return false;
+		_queued.fetch_sub(1, std::memory_order_relaxed);
+		_execute(_task.first, *_task.second);
+		return true;
+	}
+
+	// ִһ񣬼¼׳쳣Ȼļ1
+	static void _execute(std::function<void()>& _f, _avl_task_group& _group) {
+		try {
+			_f();
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> _lock(_group._mutex);
+			if (!_group._error)
+				_group._error = std::current_exception();
+		}
+		_group._pending.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void _loop(std::size_t _i) {
+		for (;;) {
+			if (_run_one(_i))
+				continue;
+			std::unique_lock<std::mutex> _lock(_sleep);
+			_wake.wait(_lock, [this]() { return _stop || _queued.load(std::memory_order_relaxed) > 0; });
+			if (_stop && !_queued.load(std::memory_order_relaxed))
+				return;
+		}
+	}
+
+public:
+	/*
+	 *	ӿڣspawn
+	 *	һ_group޷ӣڵֱִ߳С
+	 */
+	static void spawn(_avl_task_group& _group, std::function<void()> _f) {
+		_group._pending.fetch_add(1, std::memory_order_relaxed);
+		if (!_shut_down()) {
+			auto& _p = _instance();
+			if (!_p._stop) {
+				auto& _q = *_p._queues[_p._self()];
+				bool _pushed = false;
+				try {
+					std::lock_guard<std::mutex> _lock(_q.mutex);
+					_q.tasks.emplace_back(std::move(_f), &_group);
+					_pushed = true;
+				}
+				catch (...) {
+				}
+				if (_pushed) {
+					_p._queued.fetch_add(1, std::memory_order_relaxed);
+					{
+						std::lock_guard<std::mutex> _lock(_p._sleep);
+					}
+					_p._wake.notify_one();
+					return;
+				}
+			}
+		}
+		_execute(_f, _group);
+	}
+
+	/*
+	 *	ӿڣwait
+	 *	ȴ_groupеɣڼæִже
+	 *	׳쳣ɺ׳һ쳣
+	 */
+	static void wait(_avl_task_group& _group) {
+		while (_group._pending.load(std::memory_order_acquire)) {
+			if (_shut_down() || !_instance()._run_one(_instance()._self()))
+				std::this_thread::yield();
+		}
+		if (_group._error)
+			std::rethrow_exception(_group._error);
+	}
+};
+
+/*
+ * class template _avl_parallelбʵ֡
+ * avl<T, C, S, B>Ԫֱӷʽڵ㡣
+ */
+template <typename T, typename C, typename S, typename B>
+struct _avl_parallel {
+	using tree_type = avl<T, C, S, B>;
+	using node_type = typename tree_type::_node;
+
+	// ߶Ȳֵٻ֣һ߳˳Լ140ڵ㣩
+	static constexpr std::size_t grain = 10;
+
+	/*
+	 * ݽṹbounds
+	 * [low, high)ָΪձʾòûơ
+	 */
+	struct bounds {
+		const T* low;
+		const T* high;
+		const C* comp;
+
+		bool above_low(const T& _v) const {
+			return !low || !(*comp)(_v, *low);
+		}
+
+		bool below_high(const T& _v) const {
+			return !high || (*comp)(_v, *high);
+		}
+	};
+
+	static const node_type* root(const tree_type& _tree) {
+		return _tree._root;
+	}
+
+	static const C& comparator(const tree_type& _tree) {
+		return _tree._comparator;
+	}
+
+	/*
+	 * trim
+	 * ֮һ½ֱλڵĽڵ
+	 * _lo_ok_hi_okʾнڵ֪½Ͻ硣
+	 */
+	static const node_type* trim(const node_type* _n, const bounds& _b, bool _lo_ok, bool _hi_ok) {
+		while (_n) {
+			if (!_lo_ok && !_b.above_low(_n->value))
+				_n = _n->rightChild;
+			else if (!_hi_ok && !_b.below_high(_n->value))
+				_n = _n->leftChild;
+			else
+				break;
+		}
+		return _n;
+	}
+
+	/*
+	 * visit
+	 * ڵǰ߳ϰ_nڲĹĽڵ_f
+	 */
+	template <typename F>
+	static void visit(const node_type* _n, const bounds& _b, bool _lo_ok, bool _hi_ok, F& _f) {
+		if (!_n)
+			return;
+		const node_type* _last = _n;
+		while (_last->rightChild)
+			_last = _last->rightChild;
+		const node_type* _p = _n;
+		while (_p->leftChild)
+			_p = _p->leftChild;
+		for (;;) {
+			if (!_hi_ok && !_b.below_high(_p->value))
+				break;
+			if (!_p->dead && (_lo_ok || _b.above_low(_p->value)))
+				_f(_p->value);
+			if (_p == _last)
+				break;
+			_p = tree_type::_successor(_p);
+		}
+	}
+
+	/*
+	 * each
+	 * еض_nڵԪص_f֤˳
+	 */
+	template <typename F>
+	static void each(const node_type* _n, const bounds& _b, bool _lo_ok, bool _hi_ok, F& _f) {
+		_n = trim(_n, _b, _lo_ok, _hi_ok);
+		if (!_n)
+			return;
+		if (tree_type::_height(_n) <= grain) {
+			visit(_n, _b, _lo_ok, _hi_ok, _f);
+			return;
+		}
+		_avl_task_group _group;
+		auto _left = _n->leftChild;
+		_avl_work_pool::spawn(_group, [_left, &_b, _lo_ok, &_f]() {
+			each(_left, _b, _lo_ok, true, _f);
+		});
+		try {
+			if (!_n->dead)
+				_f(_n->value);
+			each(_n->rightChild, _b, true, _hi_ok, _f);
+		}
+		catch (...) {
+			try {
+				_avl_work_pool::wait(_group);
+			}
+			catch (...) {
+			}
+			throw;
+		}
+		_avl_work_pool::wait(_group);
+	}
+
+	/*
+	 * join
+	 * ˳ϲָֽʾòûԪء
+	 */
+	template <typename V, typename R>
+	static std::unique_ptr<V> join(std::unique_ptr<V> _lhs, std::unique_ptr<V> _rhs, R& _reduce) {
+		if (!_lhs)
+			return _rhs;
+		if (_rhs)
+			*_lhs = _reduce(std::move(*_lhs), std::move(*_rhs));
+		return _lhs;
+	}
+
+	/*
+	 * fold
+	 * еض_nڵԪ任ٰԼ
+	 * ǰڵ㡢ĽκϲֻҪ_reduceɡ
+	 * ֵstd::unique_ptr<V>ĹԼûԪʱΪָ롣
+	 */
+	template <typename V, typename R, typename M>
+	static std::unique_ptr<V> fold(const node_type* _n, const bounds& _b, bool _lo_ok, bool _hi_ok, R& _reduce, M& _map) {
+		_n = trim(_n, _b, _lo_ok, _hi_ok);
+		if (!_n)
+			return nullptr;
+		if (tree_type::_height(_n) <= grain) {
+			std::unique_ptr<V> _acc;
+			auto _step = [&_acc, &_reduce, &_map](const T& _v) {
+				if (_acc)
+					*_acc = _reduce(std::move(*_acc), _map(_v));
+				else
+					_acc.reset(new V(_map(_v)));
+			};
+			visit(_n, _b, _lo_ok, _hi_ok, _step);
+			return _acc;
+		}
+		_avl_task_group _group;
+		std::unique_ptr<V> _left_result;
+		auto _left = _n->leftChild;
+		_avl_work_pool::spawn(_group, [&_left_result, _left, &_b, _lo_ok, &_reduce, &_map]() {
+			_left_result = fold<V>(_left, _b, _lo_ok, true, _reduce, _map);
+		});
+		std::unique_ptr<V> _mid, _right_result;
+		try {
+			if (!_n->dead)
+				_mid.reset(new V(_map(_n->value)));
+			_right_result = fold<V>(_n->rightChild, _b, true, _hi_ok, _reduce, _map);
+		}
+		catch (...) {
+			try {
+				_avl_work_pool::wait(_group);
+			}
+			catch (...) {
+			}
+			throw;
+		}
+		_avl_work_pool::wait(_group);
+		return join(join(std::move(_left_result), std::move(_mid), _reduce), std::move(_right_result), _reduce);
+	}
+
+	template <typename F>
+	static void for_each(const tree_type& _tree, const T* _low, const T* _high, F& _f) {
+		bounds _b{ _low, _high, &comparator(_tree) };
+		each(root(_tree), _b, !_low, !_high, _f);
+	}
+
+	template <typename V, typename R, typename M>
+	static V transform_reduce(const tree_type& _tree, const T* _low, const T* _high, V _init, R& _reduce, M& _map) {
+		bounds _b{ _low, _high, &comparator(_tree) };
+		auto _result = fold<V>(root(_tree), _b, !_low, !_high, _reduce, _map);
+		if (!_result)
+			return _init;
+		return _reduce(std::move(_init), std::move(*_result));
+	}
+};
+
+/*
+ *	parallel_for_each
+ *	AVLеÿԪأ[_low, _high)еԪأ_f
+ *	_fڶ߳ͬʱãҵ˳ȷҪʱʹparallel_transform_reduce
+ *	ڼ䲻޸_f׳쳣׳
+ */
+template <typename T, typename C, typename S, typename B, typename F>
+void parallel_for_each(const avl<T, C, S, B>& _tree, F _f) {
+	_avl_parallel<T, C, S, B>::for_each(_tree, nullptr, nullptr, _f);
+}
+
+template <typename T, typename C, typename S, typename B, typename F>
+void parallel_for_each(const avl<T, C, S, B>& _tree, const T& _low, const T& _high, F _f) {
+	_avl_parallel<T, C, S, B>::for_each(_tree, &_low, &_high, _f);
+}
+
+/*
+ *	parallel_transform_reduce
+ *	_mapÿԪأ[_low, _high)еԪأ任ΪV
+ *	_reduce򽫽ϲ_initϲ_reduce(_init, ϲ)
+ *	_reduceֻɣ㽻ɣƴַʱ
+ *	_map_reduceڶ߳ͬʱáڼ䲻޸
+ *	ֵVԼĽûԪʱ_init
+ */
+template <typename T, typename C, typename S, typename B, typename V, typename R, typename M>
+V parallel_transform_reduce(const avl<T, C, S, B>& _tree, V _init, R _reduce, M _map) {
+	return _avl_parallel<T, C, S, B>::transform_reduce(_tree, nullptr, nullptr, std::move(_init), _reduce, _map);
+}
+
+template <typename T, typename C, typename S, typename B, typename V, typename R, typename M>
+V parallel_transform_reduce(const avl<T, C, S, B>& _tree, const T& _low, const T& _high, V _init, R _reduce, M _map) {
+	return _avl_parallel<T, C, S, B>::transform_reduce(_tree, &_low, &_high, std::move(_init), _reduce, _map);
+}
+
+/*
+ *	parallel_reduce
+ *	ͬԡԪתΪVΪ任parallel_transform_reduce
+ */
+template <typename T, typename C, typename S, typename B, typename V, typename R>
+V parallel_reduce(const avl<T, C, S, B>& _tree, V _init, R _reduce) {
+	auto _map = [](const T& _v) -> V { return _v; };
+	return _avl_parallel<T, C, S, B>::transform_reduce(_tree, nullptr, nullptr, std::move(_init), _reduce, _map);
+}
+
+template <typename T, typename C, typename S, typename B, typename V, typename R>
+V parallel_reduce(const avl<T, C, S, B>& _tree, const T& _low, const T& _high, V _init, R _reduce) {
+	auto _map = [](const T& _v) -> V { return _v; };
+	return _avl_parallel<T, C, S, B>::transform_reduce(_tree, &_low, &_high, std::move(_init), _reduce, _map);
+}
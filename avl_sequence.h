@@ -0,0 +1,698 @@
+/*
+	avl_sequence.hAVLʵֵİλС
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* ԪزȽ򣬶ǰλУÿڵ¼ĴС
+* iԪСԸ¶λλòɾΪO(log n)
+* ڱ༭ĹбҪƵмɾĳϡ
+* Ľṹavl.hеתάsplit_atconcat߶ȵӣjoinʵ֣
+* ͬΪO(log n)
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class avl_sequence;
+
+/*
+ * ݽṹ_avl_sequence_node
+ * Ա˵
+ * valueԪصֵ
+ * leftChildrightChildparentavl<T, C, S, B>Ľڵͬ
+ * sizeԱڵΪеԪظ
+ * heightԱڵΪĸ߶ȣҶڵΪ1
+ * еĲҪȽĸ߶ȣ˼¼߶ȶƽӡ
+ */
+template <typename T>
+struct _avl_sequence_node {
+	T value;
+	_avl_sequence_node* leftChild = nullptr;
+	_avl_sequence_node* rightChild = nullptr;
+	_avl_sequence_node* parent = nullptr;
+	std::size_t size = 1;
+	int height = 1;
+	template <typename... A>
+	explicit _avl_sequence_node(A&&... _args) : value(std::forward<A>(_args)...) {}
+};
+
+/*
+ *	class template _avl_sequence_iteratoravl_sequence˫
+ *	ģ˵
+ *	TԪ͡
+ *	VõͣΪTʱiteratorΪconst Tʱconst_iterator
+ */
+template <typename T, typename V>
+class _avl_sequence_iterator {
+	friend class avl_sequence<T>;
+	friend class _avl_sequence_iterator<T, const T>;
+
+private:
+	using _node = _avl_sequence_node<T>;
+
+	// ˽ֶΣ_container
+	const avl_sequence<T>* _container;
+	// ˽ֶΣ_valueǰָĽڵ㣬Ϊʱʾβ
+	_node* _value;
+
+	_avl_sequence_iterator(const avl_sequence<T>* _cont, _node* _n) : _container(_cont), _value(_n) {}
+
+public:
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = V*;
+	using reference = V&;
+
+	_avl_sequence_iterator() : _container(nullptr), _value(nullptr) {}
+
+	// iteratorʽתΪconst_iterator
+	_avl_sequence_iterator(const _avl_sequence_iterator<T, T>& _other)
+		: _container(_other._container), _value(_other._value) {}
+
+	V& operator*() const {
+		return _value->value;
+	}
+
+	V* operator->() const {
+		return &_value->value;
+	}
+
+	/*
+	 *	ӿڣoperator++operator--
+	 *	ڵָƶĺ̻ǰ̯ʱO(1)
+	 *	βݼõһԪء
+	 */
+	_avl_sequence_iterator& operator++() {
+		_value = avl_sequence<T>::_next(_value);
+		return *this;
+	}
+
+	_avl_sequence_iterator operator++(int) {
+		auto _copy = *this;
+		++*this;
+		return _copy;
+	}
+
+	_avl_sequence_iterator& operator--() {
+		_value = _value ? avl_sequence<T>::_prev(_value) : _container->_last();
+		return *this;
+	}
+
+	_avl_sequence_iterator operator--(int) {
+		auto _copy = *this;
+		--*this;
+		return _copy;
+	}
+
+	bool operator==(const _avl_sequence_iterator& _other) const {
+		return _value == _other._value;
+	}
+
+	bool operator!=(const _avl_sequence_iterator& _other) const {
+		return _value != _other._value;
+	}
+};
+
+/*
+ * class template avl_sequenceλС
+ * ģ˵
+ * TԪ͡ҪɱȽϣֻҪԴӲʱĲ졣
+ * ɾֻʹɾԪصĵʧЧñЧ
+ * split_atconcat֮󣬵Ԫڵתơ
+ * ӻڲ֮ͬתƽڵ㣬˽ڵ䣬ʹýڵء
+ */
+template <typename T>
+class avl_sequence {
+	template <typename, typename>
+	friend class _avl_sequence_iterator;
+
+private:
+	using _node = _avl_sequence_node<T>;
+
+	// ˽ֶΣ_rootĸڵ㣬ΪʱΪա
+	_node* _root = nullptr;
+
+	static std::size_t _size_of(const _node* _n) {
+		return _n ? _n->size : 0;
+	}
+
+	static int _height_of(const _node* _n) {
+		return _n ? _n->height : 0;
+	}
+
+	// _update¼_nĴС߶ȡ
+	static void _update(_node* _n) {
+		int _l = _height_of(_n->leftChild);
+		int _r = _height_of(_n->rightChild);
+		_n->size = _size_of(_n->leftChild) + _size_of(_n->rightChild) + 1;
+		_n->height = (_l > _r ? _l : _r) + 1;
+	}
+
+	/*
+	 * _fix_up
+	 * _nظڵָϣ´С߶ȣʧ⴦ת
+	 * 
+	 * _nһҪµĽڵ㣬Ϊա
+	 * _top_nĸڵ㣬תʱ֮¡
+	 */
+	static void _fix_up(_node* _n, _node*& _top) {
+		while (_n) {
+			_update(_n);
+			int _balance = _height_of(_n->leftChild) - _height_of(_n->rightChild);
+			if (_balance > 1) {
+				auto _l = _n->leftChild;
+				if (_height_of(_l->leftChild) < _height_of(_l->rightChild)) {
+					_avl_rotate_left(_l, _top);
+					_update(_l);
+				}
+				_n = _avl_rotate_right(_n, _top);
+				_update(_n->rightChild);
+				_update(_n);
+			}
+			else if (_balance < -1) {
+				auto _r = _n->rightChild;
+				if (_height_of(_r->rightChild) < _height_of(_r->leftChild)) {
+					_avl_rotate_right(_r, _top);
+					_update(_r);
+				}
+				_n = _avl_rotate_left(_n, _top);
+				_update(_n->leftChild);
+				_update(_n);
+			}
+			_n = _n->parent;
+		}
+	}
+
+	/*
+	 * _join
+	 * _mΪмԪأ_l_m_rΪһ
+	 * _l_röΪգ_mһĽڵ㡣
+	 * ؽϸһıԵ½ϰ߶֮_mϰ
+	 * ϵʱO(|h(_l) - h(_r)| + 1)
+	 * ֵ_node*Ӻĸڵ㡣
+	 */
+	static _node* _join(_node* _l, _node* _m, _node* _r) {
+		int _hl = _height_of(_l);
+		int _hr = _height_of(_r);
+		if (_hl > _hr + 1) {
+			// Եڽڵĸ߶ȿ2_cΪգ_p¼丸ڵ㡣
+			_node* _p = nullptr;
+			auto _c = _l;
+			while (_height_of(_c) > _hr + 1) {
+				_p = _c;
+				_c = _c->rightChild;
+			}
+			_m->leftChild = _c;
+			_m->rightChild = _r;
+			_m->parent = _p;
+			_p->rightChild = _m;
+			if (_c)
+				_c->parent = _m;
+			if (_r)
+				_r->parent = _m;
+			_update(_m);
+			_fix_up(_p, _l);
+			return _l;
+		}
+		if (_hr > _hl + 1) {
+			_node* _p = nullptr;
+			auto _c = _r;
+			while (_height_of(_c) > _hl + 1) {
+				_p = _c;
+				_c = _c->leftChild;
+			}
+			_m->rightChild = _c;
+			_m->leftChild = _l;
+			_m->parent = _p;
+			_p->leftChild = _m;
+			if (_c)
+				_c->parent = _m;
+			if (_l)
+				_l->parent = _m;
+			_update(_m);
+			_fix_up(_p, _r);
+			return _r;
+		}
+		_m->leftChild = _l;
+		_m->rightChild = _r;
+		_m->parent = nullptr;
+		if (_l)
+			_l->parent = _m;
+		if (_r)
+			_r->parent = _m;
+		_update(_m);
+		return _m;
+	}
+
+	/*
+	 * _split
+	 * _tΪΪǰ_iԪعɵ_lԪعɵ_r
+	 * Ը𿪣ٽ;Ľڵͬһӵϡ
+	 * ӵĴ֮ܺʱO(log n)ݹΪߡ
+	 */
+	static void _split(_node* _t, std::size_t _i, _node*& _l, _node*& _r) {
+		if (!_t) {
+			_l = _r = nullptr;
+			return;
+		}
+		auto _a = _t->leftChild;
+		auto _b = _t->rightChild;
+		if (_a)
+			_a->parent = nullptr;
+		if (_b)
+			_b->parent = nullptr;
+		_t->leftChild = _t->rightChild = nullptr;
+		if (_i <= _size_of(_a)) {
+			_node* _mid;
+			_split(_a, _i, _l, _mid);
+			_r = _join(_mid, _t, _b);
+		}
+		else {
+			_node* _mid;
+			_split(_b, _i - _size_of(_a) - 1, _mid, _r);
+			_l = _join(_a, _t, _mid);
+		}
+	}
+
+	/*
+	 * _at
+	 * СԸ¶λ_iԪأҪ_iСԪظ
+	 */
+	_node* _at(std::size_t _i) const {
+		auto _n = _root;
+		for (;;) {
+			std::size_t _left = _size_of(_n->leftChild);
+			if (_i < _left)
+				_n = _n->leftChild;
+			else if (_i == _left)
+				return _n;
+			else {
+				_i -= _left + 1;
+				_n = _n->rightChild;
+			}
+		}
+	}
+
+	// _first_lastһһڵ㣬Ϊʱؿա
+	_node* _first() const {
+		auto _n = _root;
+		while (_n && _n->leftChild)
+			_n = _n->leftChild;
+		return _n;
+	}
+
+	_node* _last() const {
+		auto _n = _root;
+		while (_n && _n->rightChild)
+			_n = _n->rightChild;
+		return _n;
+	}
+
+	// _next_prevĺǰʱؿա
+	static _node* _next(_node* _n) {
+		if (_n->rightChild) {
+			_n = _n->rightChild;
+			while (_n->leftChild)
+				_n = _n->leftChild;
+			return _n;
+		}
+		while (_n->parent && _n->parent->rightChild == _n)
+			_n = _n->parent;
+		return _n->parent;
+	}
+
+	static _node* _prev(_node* _n) {
+		if (_n->leftChild) {
+			_n = _n->leftChild;
+			while (_n->rightChild)
+				_n = _n->rightChild;
+			return _n;
+		}
+		while (_n->parent && _n->parent->leftChild == _n)
+			_n = _n->parent;
+		return _n->parent;
+	}
+
+	// _replace_bΪգȡ_a丸ڵеλá
+	void _replace(_node* _a, _node* _b) {
+		if (!_a->parent)
+			_root = _b;
+		else if (_a->parent->leftChild == _a)
+			_a->parent->leftChild = _b;
+		else
+			_a->parent->rightChild = _b;
+		if (_b)
+			_b->parent = _a->parent;
+	}
+
+	/*
+	 * _unlink
+	 * ڵ_xժ£ͷţϵ
+	 * _x̽ڵ㱾Ǻ̵ֵȡ_x
+	 * ԪصĵӰ졣
+	 */
+	void _unlink(_node* _x) {
+		_node* _fix;
+		if (!_x->leftChild || !_x->rightChild) {
+			_fix = _x->parent;
+			_replace(_x, _x->leftChild ? _x->leftChild : _x->rightChild);
+		}
+		else {
+			auto _y = _x->rightChild;
+			while (_y->leftChild)
+				_y = _y->leftChild;
+			if (_y->parent != _x) {
+				_fix = _y->parent;
+				_replace(_y, _y->rightChild);
+				_y->rightChild = _x->rightChild;
+				_y->rightChild->parent = _y;
+			}
+			else
+				_fix = _y;
+			_replace(_x, _y);
+			_y->leftChild = _x->leftChild;
+			_y->leftChild->parent = _y;
+		}
+		_x->leftChild = _x->rightChild = _x->parent = nullptr;
+		_x->size = 1;
+		_x->height = 1;
+		_fix_up(_fix, _root);
+	}
+
+	/*
+	 * _build
+	 * _nodesе_nڵ㰴˳һȫƽʱO(n)
+	 */
+	static _node* _build(_node* const* _nodes, std::size_t _n) {
+		if (!_n)
+			return nullptr;
+		std::size_t _mid = _n / 2;
+		auto _m = _nodes[_mid];
+		_m->leftChild = _build(_nodes, _mid);
+		_m->rightChild = _build(_nodes + _mid + 1, _n - _mid - 1);
+		if (_m->leftChild)
+			_m->leftChild->parent = _m;
+		if (_m->rightChild)
+			_m->rightChild->parent = _m;
+		_update(_m);
+		return _m;
+	}
+
+	/*
+	 * _assign
+	 * [_first, _last)еԪ滻еݡ
+	 * ȹȫڵ㣬׳쳣ͷѹĽڵ㣬бֲ䡣
+	 */
+	template <typename I>
+	void _assign(I _first, I _last) {
+		std::vector<_node*> _nodes;
+		try {
+			for (; _first != _last; ++_first) {
+				_nodes.push_back(nullptr);
+				_nodes.back() = new _node(*_first);
+			}
+		}
+		catch (...) {
+			for (auto _n : _nodes)
+				delete _n;
+			throw;
+		}
+		clear();
+		_root = _build(_nodes.data(), _nodes.size());
+		if (_root)
+			_root->parent = nullptr;
+	}
+
+	// _destroyԺͷ_nΪݹΪߡ
+	static void _destroy(_node* _n) {
+		if (!_n)
+			return;
+		_destroy(_n->leftChild);
+		_destroy(_n->rightChild);
+		delete _n;
+	}
+
+public:
+	using size_type = std::size_t;
+	using value_type = T;
+	using iterator = _avl_sequence_iterator<T, T>;
+	using const_iterator = _avl_sequence_iterator<T, const T>;
+
+	avl_sequence() = default;
+
+	/*
+	 *	ӿڣ
+	 *	[_first, _last)ʼбеԪذ˳УʱO(n)
+	 */
+	template <typename I>
+	avl_sequence(I _first, I _last) {
+		_assign(_first, _last);
+	}
+
+	avl_sequence(std::initializer_list<T> _list) {
+		_assign(_list.begin(), _list.end());
+	}
+
+	/*
+	 *	ӿڣ캯뿽ֵ
+	 *	˳Ԫز´һȫƽʱO(n)
+	 */
+	avl_sequence(const avl_sequence& _src) {
+		_assign(_src.begin(), _src.end());
+	}
+
+	avl_sequence& operator=(const avl_sequence& _src) {
+		if (this != &_src)
+			_assign(_src.begin(), _src.end());
+		return *this;
+	}
+
+	/*
+	 *	ӿڣƶ캯ƶֵ
+	 *	ȡƶΪС
+	 */
+	avl_sequence(avl_sequence&& _src) noexcept : _root(_src._root) {
+		_src._root = nullptr;
+	}
+
+	avl_sequence& operator=(avl_sequence&& _src) noexcept {
+		if (this != &_src) {
+			clear();
+			_root = _src._root;
+			_src._root = nullptr;
+		}
+		return *this;
+	}
+
+	~avl_sequence() {
+		clear();
+	}
+
+	/*
+	 *	ӿڣsize()empty()
+	 *	Ԫظ¼ڸڵУʱO(1)
+	 */
+	size_type size() const {
+		return _size_of(_root);
+	}
+
+	bool empty() const {
+		return !_root;
+	}
+
+	/*
+	 *	ӿڣoperator[](size_type)
+	 *	ֵ_iԪصãʱO(log n)
+	 *	_iСsize()ʱᵼ²ȷΪ
+	 */
+	T& operator[](size_type _i) {
+		return _at(_i)->value;
+	}
+
+	const T& operator[](size_type _i) const {
+		return _at(_i)->value;
+	}
+
+	/*
+	 *	ӿڣemplace_atinsert_at
+	 *	ڵ_iԪ֮ǰһԪأ_isize()ʱ뵽ĩβʱO(log n)
+	 *	_isize()ʱᵼ²ȷΪԪصĹ׳쳣бֲ䡣
+	 *	ֵiteratorָ²Ԫء
+	 */
+	template <typename... A>
+	iterator emplace_at(size_type _i, A&&... _args) {
+		auto _n = new _node(std::forward<A>(_args)...);
+		if (!_root)
+			_root = _n;
+		else if (_i == size()) {
+			auto _p = _last();
+			_p->rightChild = _n;
+			_n->parent = _p;
+		}
+		else {
+			auto _p = _at(_i);
+			if (!_p->leftChild)
+				_p->leftChild = _n;
+			else {
+				_p = _p->leftChild;
+				while (_p->rightChild)
+					_p = _p->rightChild;
+				_p->rightChild = _n;
+			}
+			_n->parent = _p;
+		}
+		_fix_up(_n->parent, _root);
+		return iterator(this, _n);
+	}
+
+	iterator insert_at(size_type _i, const T& _value) {
+		return emplace_at(_i, _value);
+	}
+
+	iterator insert_at(size_type _i, T&& _value) {
+		return emplace_at(_i, std::move(_value));
+	}
+
+	void push_back(const T& _value) {
+		emplace_at(size(), _value);
+	}
+
+	void push_back(T&& _value) {
+		emplace_at(size(), std::move(_value));
+	}
+
+	/*
+	 *	ӿڣerase_at(size_type)erase(const_iterator)
+	 *	ɾ_iԪػָԪأʱO(log n)
+	 *	ֵiteratorָɾԪصһԪء
+	 */
+	iterator erase_at(size_type _i) {
+		return erase(const_iterator(this, _at(_i)));
+	}
+
+	iterator erase(const_iterator _pos) {
+		auto _x = _pos._value;
+		auto _following = _next(_x);
+		_unlink(_x);
+		delete _x;
+		return iterator(this, _following);
+	}
+
+	/*
+	 *	ӿڣindex_of(const_iterator)
+	 *	ֵsize_typeָԪصλãβλΪsize()ʱO(log n)
+	 */
+	size_type index_of(const_iterator _pos) const {
+		auto _n = _pos._value;
+		if (!_n)
+			return size();
+		size_type _i = _size_of(_n->leftChild);
+		for (; _n->parent; _n = _n->parent)
+			if (_n->parent->rightChild == _n)
+				_i += _size_of(_n->parent->leftChild) + 1;
+		return _i;
+	}
+
+	/*
+	 *	ӿڣsplit_at(size_type)
+	 *	ڵ_iԪ֮ǰ𿪣бǰ_iԪأԪ뷵صС
+	 *	ԪأʱO(log n)_iСsize()ʱؿС
+	 *	ֵavl_sequenceԭλòС_iԪء
+	 */
+	avl_sequence split_at(size_type _i) {
+		avl_sequence _rest;
+		if (_i >= size())
+			return _rest;
+		_node* _l;
+		_split(_root, _i, _l, _rest._root);
+		_root = _l;
+		return _rest;
+	}
+
+	/*
+	 *	ӿڣconcat(avl_sequence&)concat(avl_sequence&&)
+	 *	_otherеԪذ˳ڱĩβ_other֮ΪС
+	 *	ȡ_otherĵһԪΪӵ㣬ԪأʱO(log n)
+	 */
+	void concat(avl_sequence& _other) {
+		if (this == &_other || !_other._root)
+			return;
+		if (!_root) {
+			std::swap(_root, _other._root);
+			return;
+		}
+		auto _m = _other._first();
+		_other._unlink(_m);
+		_root = _join(_root, _m, _other._root);
+		_other._root = nullptr;
+	}
+
+	void concat(avl_sequence&& _other) {
+		concat(_other);
+	}
+
+	/*
+	 *	ӿڣclear()
+	 *	ͷԪء
+	 */
+	void clear() {
+		_destroy(_root);
+		_root = nullptr;
+	}
+
+	void swap(avl_sequence& _other) noexcept {
+		std::swap(_root, _other._root);
+	}
+
+	/*
+	 *	ӿ壺beginend
+	 *	λ˳Ԫء
+	 */
+	iterator begin() {
+		return iterator(this, _first());
+	}
+
+	iterator end() {
+		return iterator(this, nullptr);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(this, _first());
+	}
+
+	const_iterator end() const {
+		return const_iterator(this, nullptr);
+	}
+
+	const_iterator cbegin() const {
+		return begin();
+	}
+
+	const_iterator cend() const {
+		return end();
+	}
+};
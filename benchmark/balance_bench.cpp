@@ -0,0 +1,128 @@
+/*
+	balance_bench.cppȽϸƽԵתʱ
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ룬磺
+* g++ -std=c++14 -O2 -I.. balance_bench.cpp -o balance_bench
+* Programmed By Lucas.
+* avl_strict_balanceavl_weak_balanceavl_relaxed_balance¸أ
+* insertnԪأ
+* churnnԪصĻɾ
+* drainɾ󲿷Ԫأ
+* lookupھҡ
+* תݲavl_counting_statsռʱΪÿβƽ
+*/
+
+#include "../avl.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+	using _clock = std::chrono::steady_clock;
+
+	// һ׶νʱļʱ
+	struct _phase {
+		const char* name;
+		double ns_per_op;
+		std::uint64_t rotations;
+		std::uint64_t retrace_steps;
+		std::size_t height;
+	};
+
+	std::uint64_t _rotations(const avl_stats_snapshot& _s) {
+		std::uint64_t _total = 0;
+		for (auto _r : _s.rotations)
+			_total += _r;
+		return _total;
+	}
+
+	/*
+	 * _measure
+	 * ִһ׶Σظý׶εƽʱԼתݲ
+	 */
+	template <typename Tree, typename F>
+	_phase _measure(const char* _name, Tree& _tree, std::size_t _ops, F _body) {
+		auto _before = _tree.stats();
+		auto _start = _clock::now();
+		_body();
+		auto _elapsed = std::chrono::duration<double, std::nano>(_clock::now() - _start).count();
+		auto _after = _tree.stats();
+		return _phase{ _name, _ops ? _elapsed / static_cast<double>(_ops) : 0,
+			_rotations(_after) - _rotations(_before),
+			_after.retrace_steps - _before.retrace_steps, _after.height };
+	}
+
+	template <typename B>
+	void _run(const char* _policy, std::size_t _n, unsigned _seed) {
+		avl<std::uint64_t, std::less<std::uint64_t>, avl_counting_stats, B> _tree;
+		std::mt19937_64 _rng(_seed);
+		std::vector<std::uint64_t> _keys(_n);
+		for (auto& _k : _keys)
+			_k = _rng();
+		std::vector<_phase> _phases;
+
+		_phases.push_back(_measure("insert", _tree, _n, [&]() {
+			for (auto _k : _keys)
+				_tree.put(_k);
+		}));
+
+		_phases.push_back(_measure("churn", _tree, 2 * _n, [&]() {
+			for (std::size_t _i = 0; _i < _n; _i++) {
+				std::uint64_t _k = _rng();
+				_tree.put(_k);
+				std::size_t _j = static_cast<std::size_t>(_rng() % _n);
+				_tree.remove(_keys[_j]);
+				_keys[_j] = _k;
+			}
+		}));
+
+		std::size_t _drained = _n - _n / 8;
+		_phases.push_back(_measure("drain", _tree, _drained, [&]() {
+			for (std::size_t _i = 0; _i < _drained; _i++)
+				_tree.remove(_keys[_i]);
+		}));
+
+		volatile std::size_t _hits = 0;
+		_phases.push_back(_measure("lookup", _tree, _n, [&]() {
+			for (std::size_t _i = 0; _i < _n; _i++)
+				_hits = _hits + _tree.find(_keys[_drained + static_cast<std::size_t>(_rng() % (_n - _drained))]);
+		}));
+
+		for (auto& _p : _phases)
+			std::printf("%-8s %-8s %10.1f %12llu %14llu %7zu\n", _policy, _p.name, _p.ns_per_op,
+				static_cast<unsigned long long>(_p.rotations),
+				static_cast<unsigned long long>(_p.retrace_steps), _p.height);
+	}
+
+}
+
+int main(int argc, char** argv) {
+	std::size_t _n = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+	if (_n < 8)
+		_n = 8;
+	std::printf("n = %zu\n", _n);
+	std::printf("%-8s %-8s %10s %12s %14s %7s\n", "policy", "phase", "ns/op", "rotations", "retrace_steps", "height");
+	_run<avl_strict_balance>("strict", _n, 1);
+	_run<avl_weak_balance>("weak", _n, 1);
+	_run<avl_relaxed_balance>("relaxed", _n, 1);
+	return 0;
+}
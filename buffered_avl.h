@@ -0,0 +1,281 @@
+/*
+	buffered_avl.hдAVLǰˡ
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* putremoveȼ¼һСĻУʱAVL
+* ¼¼ֱ׷ڻĩβʱɨЩ׷ӵļ¼ٶֲĲ֣
+* ׷ӵļ¼򲿷ֵһʱ鲢ͬһֵĶβʱϲΪһΣ
+* ʱavl<T, C, S, B>::put_sortedremove_sortedһɡ
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/*
+ * class template buffered_avlдAVL
+ * ģclass template avlһ˴׸
+ * ͬʱѯ׼ȷġ
+ * size()tree()ҪȽУ
+ * ЩconstԱҲ޸ڲݣá
+ */
+template <typename T, typename C = std::less<T>, typename S = avl_no_stats, typename B = avl_strict_balance>
+class buffered_avl {
+private:
+	/*
+	 * ݽṹ_entry
+	 * еһ¼
+	 * Ա˵
+	 * valueֵ
+	 * eraseΪtrueʱʾɾʾ롣
+	 */
+	struct _entry {
+		T value;
+		bool erase;
+	};
+
+	// ˽ֶΣ_treeΪavl<T, C, S, B>Ѳݡ
+	mutable avl<T, C, S, B> _tree;
+	// ˽ֶΣ_bufferļ¼
+	// ǰ_sortedȽÿֵһΪ˳׷ӵļ¼
+	mutable std::vector<_entry> _buffer;
+	mutable std::size_t _sorted = 0;
+	// ˽ֶΣ_capacity¼ﵽֵʱС
+	std::size_t _capacity;
+	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
+	C _comparator;
+	// ʱ򼴿ɨ׷Ӽ¼ޡ
+	static constexpr std::size_t _tail_limit = 16;
+
+	/*
+	 * _normalize
+	 * ׷ӵļ¼򲿷ֹ鲢ȶģ
+	 * ˡȡļ¼˳Уֻһɡ
+	 * ʱΪO(t log t + b)tΪ׷ӵļ¼bΪС
+	 */
+	void _normalize() const {
+		if (_sorted == _buffer.size())
+			return;
+		auto _less = [this](const _entry& _lhs, const _entry& _rhs) {
+			return _comparator(_lhs.value, _rhs.value);
+		};
+		auto _mid = _buffer.begin() + static_cast<std::ptrdiff_t>(_sorted);
+		std::stable_sort(_mid, _buffer.end(), _less);
+		std::inplace_merge(_buffer.begin(), _mid, _buffer.end(), _less);
+		std::size_t _w = 0;
+		for (std::size_t _i = 0; _i < _buffer.size(); _i++) {
+			if (_w && !_less(_buffer[_w - 1], _buffer[_i]))
+				_buffer[_w - 1] = std::move(_buffer[_i]);
+			else if (_w++ != _i)
+				_buffer[_w - 1] = std::move(_buffer[_i]);
+		}
+		_buffer.erase(_buffer.begin() + static_cast<std::ptrdiff_t>(_w), _buffer.end());
+		_sorted = _w;
+	}
+
+	/*
+	 * _lookup
+	 * һ_valueȡһ¼׷ӵļ¼򲿷ֵİ˷֮һ_tail_limit
+	 * ȵ_normalizeȻɨ׷ӵļ¼δҵʱٶֲĲ֡
+	 * ˲ҵĴΪO(log b + b / 8)鲢Ĵ۾̯˷֮һС׷ϡ
+	 * ֵ_entry*δҵʱΪա
+	 */
+	_entry* _lookup(const T& _value) const {
+		if (_buffer.size() - _sorted > _sorted / 8 + _tail_limit)
+			_normalize();
+		for (std::size_t _i = _buffer.size(); _i > _sorted; _i--) {
+			auto& _e = _buffer[_i - 1];
+			if (!_comparator(_e.value, _value) && !_comparator(_value, _e.value))
+				return &_e;
+		}
+		auto _end = _buffer.begin() + static_cast<std::ptrdiff_t>(_sorted);
+		auto _it = std::lower_bound(_buffer.begin(), _end, _value,
+			[this](const _entry& _e, const T& _v) { return _comparator(_e.value, _v); });
+		if (_it != _end && !_comparator(_value, _it->value))
+			return &*_it;
+		return nullptr;
+	}
+
+	/*
+	 * _merge
+	 * еļ¼Уɾٲ롣
+	 * ݵȵģʱ׳쳣ֲ䣬֮ٴβ롣
+	 */
+	void _merge() const {
+		if (_buffer.empty())
+			return;
+		_normalize();
+		std::vector<std::reference_wrapper<const T>> _puts, _erases;
+		for (auto& _e : _buffer)
+			(_e.erase ? _erases : _puts).push_back(std::cref(_e.value));
+		_tree.remove_sorted(_erases.begin(), _erases.end());
+		_tree.put_sorted(_puts.begin(), _puts.end());
+		_buffer.clear();
+		_sorted = 0;
+	}
+
+public:
+	using size_type = std::size_t;
+	using const_iterator = typename avl<T, C, S, B>::const_iterator;
+	using iterator = const_iterator;
+
+	/*
+	 *	ӿڣ
+	 *	
+	 *	_capĬΪ256¼Ϊ0ʱͬڲʹû塣
+	 *	Խ󣬲ʱԽп߹鲢ؽ·дԽߣһĴҲԽ
+	 *	Ĭֵʹһ֮ڣֻдĳϿõø
+	 *	_compȽ
+	 */
+	explicit buffered_avl(size_type _cap = 256, C _comp = C())
+		: _tree(_comp), _capacity(_cap), _comparator(_comp) {}
+
+	/*
+	 *	ӿڣset_buffer_capacity(size_type)buffer_capacity()
+	 *	ûѯСм¼ʱ롣
+	 */
+	void set_buffer_capacity(size_type _cap) {
+		_capacity = _cap;
+		if (_buffer.size() >= _capacity)
+			_merge();
+	}
+
+	size_type buffer_capacity() const {
+		return _capacity;
+	}
+
+	/*
+	 *	ӿڣbuffered()
+	 *	ֵsize_typeδļ¼
+	 */
+	size_type buffered() const {
+		return _buffer.size();
+	}
+
+	/*
+	 *	ӿڣflush()
+	 *	ем¼С
+	 */
+	void flush() {
+		_merge();
+	}
+
+	/*
+	 *	ӿڣput
+	 *	һֵڻĩβ׷һ¼̯ΪO(1)
+	 *	
+	 *	_valueΪconst T&ֵ
+	 */
+	void put(const T& _value) {
+		if (_buffer.size() >= _capacity) {
+			_merge();
+			if (!_capacity) {
+				_tree.put(_value);
+				return;
+			}
+		}
+		_buffer.push_back(_entry{ _value, false });
+	}
+
+	/*
+	 *	ӿڣremove
+	 *	ɾһֵûиֵļ¼ҪвһΣ
+	 *	Ա׼ȷطɾǷɹĽṹ
+	 *	ֵboolָʾɾǰֵǷλС
+	 */
+	bool remove(const T& _value) {
+		if (auto _e = _lookup(_value)) {
+			if (_e->erase)
+				return false;
+			_e->erase = true;
+			return true;
+		}
+		if (!_tree.find(_value))
+			return false;
+		if (_buffer.size() >= _capacity) {
+			_merge();
+			if (!_capacity)
+				return _tree.remove(_value);
+		}
+		_buffer.push_back(_entry{ _value, true });
+		return true;
+	}
+
+	/*
+	 *	ӿڣfind
+	 *	ڻвңûм¼ʱٲ
+	 *	ֵboolʾǷҵ
+	 */
+	bool find(const T& _value) const {
+		if (auto _e = _lookup(_value))
+			return !_e->erase;
+		return _tree.find(_value);
+	}
+
+	/*
+	 *	ӿڣsize()empty()
+	 *	Ȳ뻺ٷĴС
+	 */
+	size_type size() const {
+		_merge();
+		return _tree.size();
+	}
+
+	bool empty() const {
+		_merge();
+		return _tree.empty();
+	}
+
+	/*
+	 *	ӿڣclear()
+	 *	еļ¼
+	 */
+	void clear() {
+		_buffer.clear();
+		_sorted = 0;
+		_tree.clear();
+	}
+
+	/*
+	 *	ӿڣtree()
+	 *	Ȳ뻺ٷصײAVLlocateͳƵֻ
+	 */
+	const avl<T, C, S, B>& tree() const {
+		_merge();
+		return _tree;
+	}
+
+	/*
+	 *	ӿ壺beginend
+	 *	Ȳ뻺ٷصײAVLĵ
+	 *	putremoveٴβ뻺ʱЧavl<T, C, S, B>ͬ
+	 */
+	const_iterator begin() const {
+		_merge();
+		return _tree.cbegin();
+	}
+
+	const_iterator end() const {
+		return _tree.cend();
+	}
+};
@@ -0,0 +1,687 @@
+/*
+	durable_avl.hԤд־ʵֱȫAVL
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* ÿʵ޸Ԫʱڴ滺׷һ־¼ύд־ļ
+* ͬһʱ̵ȴ̵Ķֻ߳һִwritefdatasync̵߳ļ¼֮һ̣
+* ˶̲߳޸ʱÿ޸Ĵÿ޸һfdatasync
+* ־һСʱд㣺˳дĽտգ̺ض־
+* ָʱO(n)Ĵ۴ļؽ
+* ٽ־ʣಿַ򡢺ϲapply_deltaطš
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * struct template avl_codecdurable_avlԪд־ʱʹõı롣
+ * encode_value׷ӵ_outĩβdecode[_p, _p + _n)лָԪأݲϷʱfalse
+ * ͨð汾ֽڸƿƽƵֵֽͣͬͬĻ֮䲻ܹļ
+ * ṩͬӿڵı룬Ϊdurable_avlģCodec
+ */
+template <typename T>
+struct avl_codec {
+	static_assert(std::is_trivially_copyable<T>::value, "avl_codec: T is not trivially copyable, provide a codec");
+
+	static void encode(const T& _value, std::string& _out) {
+		_out.append(reinterpret_cast<const char*>(&_value), sizeof(T));
+	}
+
+	static bool decode(const char* _p, std::size_t _n, T& _value) {
+		if (_n != sizeof(T))
+			return false;
+		std::memcpy(&_value, _p, sizeof(T));
+		return true;
+	}
+};
+
+// avl_codecstd::stringػֱдַݣ־¼
+template <typename A>
+struct avl_codec<std::basic_string<char, std::char_traits<char>, A>> {
+	using string_type = std::basic_string<char, std::char_traits<char>, A>;
+
+	static void encode(const string_type& _value, std::string& _out) {
+		_out.append(_value.data(), _value.size());
+	}
+
+	static bool decode(const char* _p, std::size_t _n, string_type& _value) {
+		_value.assign(_p, _n);
+		return true;
+	}
+};
+
+/*
+ * struct avl_durable_optionsdurable_avlĳ־ûѡ
+ * Ա˵
+ * syncΪtrueʱputremove־¼̺ŷأΪfalseʱֻ׷ӵڴ滺
+ * дsync()дʱ̣ʱܶʧ޸ģ̵Ĳġ
+ * buffer_bytessyncΪfalseʱĴСֽڣ
+ * checkpoint_bytes־ôСʱԶд㲢ض־Ϊ0ʱֻڵcheckpoint()ʱд롣
+ * Զдʧʱ׳쳣־checkpoint_bytes֮ԡ
+ */
+struct avl_durable_options {
+	bool sync = true;
+	std::size_t buffer_bytes = std::size_t(1) << 20;
+	std::size_t checkpoint_bytes = std::size_t(64) << 20;
+};
+
+/*
+ * struct avl_durable_stats־ûͳϢdurable_avl::durability_stats()ɡ
+ * Ա˵
+ * recordsд־ļ¼
+ * syncs־̣fdatasyncĴύʱԶСrecords
+ * log_bytesǰ־ļĴСֽڣ
+ * checkpointsдĴ
+ * replayedָʱ־طŵļ¼
+ */
+struct avl_durable_stats {
+	std::uint64_t records = 0;
+	std::uint64_t syncs = 0;
+	std::uint64_t log_bytes = 0;
+	std::uint64_t checkpoints = 0;
+	std::uint64_t replayed = 0;
+};
+
+/*
+ * function _avl_crc32CRC-32ʽ0xEDB88320ڷдһļ¼𻵵ļ
+ * _crcΪ֮ǰݵĽɷֶμ㡣
+ */
+inline std::uint32_t _avl_crc32(const char* _p, std::size_t _n, std::uint32_t _crc = 0) {
+	static const std::vector<std::uint32_t> _table = [] {
+		std::vector<std::uint32_t> _t(256);
+		for (std::uint32_t _i = 0; _i < 256; _i++) {
+			std::uint32_t _c = _i;
+			for (int _k = 0; _k < 8; _k++)
+				_c = _c & 1 ? 0xEDB88320u ^ (_c >> 1) : _c >> 1;
+			_t[_i] = _c;
+		}
+		return _t;
+	}();
+	_crc = ~_crc;
+	for (std::size_t _i = 0; _i < _n; _i++)
+		_crc = _table[(_crc ^ static_cast<unsigned char>(_p[_i])) & 0xFF] ^ (_crc >> 8);
+	return ~_crc;
+}
+
+// Сдʹļʽֽ޹ء
+inline void _avl_put_u32(std::string& _out, std::uint32_t _v) {
+	for (int _i = 0; _i < 4; _i++)
+		_out.push_back(static_cast<char>((_v >> (8 * _i)) & 0xFF));
+}
+
+inline void _avl_put_u64(std::string& _out, std::uint64_t _v) {
+	for (int _i = 0; _i < 8; _i++)
+		_out.push_back(static_cast<char>((_v >> (8 * _i)) & 0xFF));
+}
+
+inline std::uint32_t _avl_get_u32(const char* _p) {
+	std::uint32_t _v = 0;
+	for (int _i = 3; _i >= 0; _i--)
+		_v = (_v << 8) | static_cast<unsigned char>(_p[_i]);
+	return _v;
+}
+
+inline std::uint64_t _avl_get_u64(const char* _p) {
+	std::uint64_t _v = 0;
+	for (int _i = 7; _i >= 0; _i--)
+		_v = (_v << 8) | static_cast<unsigned char>(_p[_i]);
+	return _v;
+}
+
+/*
+ * class _avl_fileֻ׷дļװƽ̨ϵͳá
+ * ʧܾstd::system_error档
+ */
+class _avl_file {
+private:
+	int _fd = -1;
+
+	[[noreturn]] static void _fail(const char* _what) {
+		throw std::system_error(errno, std::generic_category(), _what);
+	}
+
+public:
+	_avl_file() = default;
+	_avl_file(const _avl_file&) = delete;
+	_avl_file& operator=(const _avl_file&) = delete;
+
+	~_avl_file() {
+		close();
+	}
+
+	// 򿪣Ҫʱļд׷ĩβ_truncateΪtrueʱա
+	void open(const std::string& _path, bool _truncate) {
+		close();
+#ifdef _WIN32
+		_fd = ::_open(_path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (_truncate ? _O_TRUNC : 0), _S_IREAD | _S_IWRITE);
+#else
+		_fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | (_truncate ? O_TRUNC : 0), 0644);
+#endif
+		if (_fd < 0)
+			_fail("avl: open");
+	}
+
+	void write(const char* _p, std::size_t _n) {
+		while (_n) {
+#ifdef _WIN32
+			int _w = ::_write(_fd, _p, static_cast<unsigned>(_n < (1u << 30) ? _n : (1u << 30)));
+#else
+			auto _w = ::write(_fd, _p, _n);
+#endif
+			if (_w < 0) {
+				if (errno == EINTR)
+					continue;
+				_fail("avl: write");
+			}
+			_p += _w;
+			_n -= static_cast<std::size_t>(_w);
+		}
+	}
+
+	// дֻ̡ļС̣ʹfdatasync
+	void sync() {
+#if defined(_WIN32)
+		if (::_commit(_fd))
+			_fail("avl: commit");
+#elif defined(__APPLE__)
+		if (::fsync(_fd))
+			_fail("avl: fsync");
+#else
+		if (::fdatasync(_fd))
+			_fail("avl: fdatasync");
+#endif
+	}
+
+	void truncate(std::uint64_t _size) {
+#ifdef _WIN32
+		if (::_chsize_s(_fd, static_cast<long long>(_size)))
+			_fail("avl: truncate");
+#else
+		if (::ftruncate(_fd, static_cast<off_t>(_size)))
+			_fail("avl: truncate");
+#endif
+	}
+
+	void close() {
+		if (_fd < 0)
+			return;
+#ifdef _WIN32
+		::_close(_fd);
+#else
+		::close(_fd);
+#endif
+		_fd = -1;
+	}
+
+	// ļļʱfalse
+	static bool read_all(const std::string& _path, std::string& _out) {
+		std::ifstream _in(_path, std::ios::binary);
+		if (!_in)
+			return false;
+		_out.assign(std::istreambuf_iterator<char>(_in), std::istreambuf_iterator<char>());
+		if (_in.bad())
+			throw std::runtime_error("avl: failed to read " + _path);
+		return true;
+	}
+
+	/*
+	 * _from滻_toʹ滻̡
+	 * POSIXrenameԭӵģWindowsɾ_toٸ
+	 * ֮ʱֻʣ_fromָʱdurable_avl::_load_checkpoint
+	 */
+	static void replace(const std::string& _from, const std::string& _to) {
+#ifdef _WIN32
+		std::remove(_to.c_str());
+#endif
+		if (std::rename(_from.c_str(), _to.c_str()))
+			_fail("avl: rename");
+#ifndef _WIN32
+		auto _slash = _to.find_last_of('/');
+		std::string _dir = _slash == std::string::npos ? "." : _slash ? _to.substr(0, _slash) : "/";
+		int _fd = ::open(_dir.c_str(), O_RDONLY);
+		if (_fd >= 0) {
+			::fsync(_fd);
+			::close(_fd);
+		}
+#endif
+	}
+};
+
+/*
+ * class template durable_avlȫAVL
+ * ģ˵
+ * TCSBclass template avlͬ
+ * CodecԪصı룬struct template avl_codec
+ * ݴļУ_path + ".wal"Ϊ־_path + ".ckpt"Ϊ㡣
+ * ־¼ĸʽΪȣ4ֽڣCRC-324ֽڣ1ֽڣ0Ϊ롢1ΪɾԪء
+ * ʱдһļ¼ڻָʱɳCRC֣ͬһȥ
+ * ĸʽΪ8ֽڵıʶԪظ8ֽڣ˳еĸԪأ4ֽڵĳȿͷ
+ * ǴǰȫݵCRC-32дʱļ̺滻ԭеļ㣬ȻŽض־
+ * κʱ̱־ǰȫ̵޸ģ
+ * ־еļ¼ʹѷӳڼУطŵĽҲͬΪɾݵȵġ
+ * йӿھɶ̲߳á޸֮ǰͶ̵߳Ĳҿɼ
+ * дļʧܺ󣬴˺޸ľ׳ͬһ쳣ڴеֿɶҪ´Իָ
+ */
+template <typename T, typename C = std::less<T>, typename S = avl_no_stats, typename B = avl_strict_balance,
+	typename Codec = avl_codec<T>>
+class durable_avl {
+private:
+	static constexpr char _magic[9] = "AVLCKPT1";
+	// ָʱÿ򡢺ϲطŵ־¼
+	static constexpr std::size_t _replay_batch = std::size_t(1) << 16;
+
+	// ˽ֶΣ_mutexֶΡ
+	mutable std::mutex _mutex;
+	// ˽ֶΣ_committedÿ־̣ʧܣ֪ͨȴߡ
+	std::condition_variable _committed;
+	// ˽ֶΣ_treeڴе
+	avl<T, C, S, B> _tree;
+	// ˽ֶΣ_pathļǰ׺
+	std::string _path;
+	avl_durable_options _options;
+	// ˽ֶΣ_wal־ļ
+	_avl_file _wal;
+	// ˽ֶΣ_buffer׷ӡδд־ļļ¼
+	std::string _buffer;
+	// ˽ֶΣ_appended_durable׷ӵһ¼ţԼ̵һ¼š
+	std::uint64_t _appended = 0;
+	std::uint64_t _durable = 0;
+	// ˽ֶΣ_flushingǷ߳д־ļ̣ύķߣ
+	bool _flushing = false;
+	// ˽ֶΣ_failureдļʧʱ쳣˺޸ľ׳
+	std::exception_ptr _failure;
+	avl_durable_stats _stats;
+	// ˽ֶΣ_checkpoint_backoffԶдʧʱ־Сһڴ֮checkpoint_bytesʱԡ
+	std::uint64_t _checkpoint_backoff = 0;
+	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
+	C _comparator;
+
+	std::string _wal_path() const {
+		return _path + ".wal";
+	}
+
+	std::string _checkpoint_path() const {
+		return _path + ".ckpt";
+	}
+
+	void _check() const {
+		if (_failure)
+			std::rethrow_exception(_failure);
+	}
+
+	/*
+	 * _append
+	 * ڻĩβ׷һ¼ʧʱֲ䡣
+	 * ֵstd::uint64_t¼š
+	 */
+	std::uint64_t _append(const T& _value, bool _erase) {
+		std::size_t _mark = _buffer.size();
+		try {
+			_buffer.append(8, '\0');
+			_buffer.push_back(_erase ? 1 : 0);
+			Codec::encode(_value, _buffer);
+		}
+		catch (...) {
+			_buffer.resize(_mark);
+			throw;
+		}
+		std::size_t _body = _mark + 8;
+		std::size_t _n = _buffer.size() - _body;
+		std::string _header;
+		_avl_put_u32(_header, static_cast<std::uint32_t>(_n));
+		_avl_put_u32(_header, _avl_crc32(&_buffer[_body], _n));
+		_buffer.replace(_mark, 8, _header);
+		_stats.records++;
+		return ++_appended;
+	}
+
+	// _retractһ׷_markļ¼޸ʧʱ
+	void _retract(std::size_t _mark) {
+		_buffer.resize(_mark);
+		_appended--;
+		_stats.records--;
+	}
+
+	/*
+	 * _wait
+	 * ȴΪ_lsnļ¼̣ύ
+	 * ụ̂߳ɵǰ߳ȡͷд벢̣
+	 * ȴڽеɣټԼļ¼ǷѰڡ
+	 * _lock
+	 */
+	void _wait(std::unique_lock<std::mutex>& _lock, std::uint64_t _lsn) {
+		while (_durable < _lsn) {
+			_check();
+			if (_flushing) {
+				_committed.wait(_lock);
+				continue;
+			}
+			_flushing = true;
+			std::string _batch;
+			_batch.swap(_buffer);
+			std::uint64_t _upto = _appended;
+			_lock.unlock();
+			std::exception_ptr _error;
+			try {
+				_wal.write(_batch.data(), _batch.size());
+				_wal.sync();
+			}
+			catch (...) {
+				_error = std::current_exception();
+			}
+			_lock.lock();
+			_flushing = false;
+			if (_error)
+				_failure = _error;
+			else {
+				_durable = _upto;
+				_stats.syncs++;
+				_stats.log_bytes += _batch.size();
+			}
+			_committed.notify_all();
+		}
+	}
+
+	/*
+	 * _commit
+	 * ޸֮ãͬģʽµȴΪ_lsnļ¼̣첽ģʽ»дʱ̣
+	 * ־趨ĴСʱд㡣ʱ޸ıѾɣ
+	 * ˼дʧܣ޷滻ļ߱棬ֻƳһγԣ
+	 * ־дʧȻ׳
+	 */
+	void _commit(std::unique_lock<std::mutex>& _lock, std::uint64_t _lsn) {
+		if (_options.sync || _buffer.size() >= _options.buffer_bytes)
+			_wait(_lock, _lsn);
+		if (_options.checkpoint_bytes && _stats.log_bytes >= _checkpoint_backoff + _options.checkpoint_bytes && !_flushing) {
+			try {
+				_checkpoint(_lock);
+			}
+			catch (...) {
+				_check();
+				_checkpoint_backoff = _stats.log_bytes;
+			}
+		}
+	}
+
+	/*
+	 * _checkpoint
+	 * ʹеļ¼ọٰ̈̄˳д滻ԭеļض־
+	 * дڼһֱʱO(n)
+	 * дʧʱ׳쳣־Ӱ˺޸ġ
+	 */
+	void _checkpoint(std::unique_lock<std::mutex>& _lock) {
+		_wait(_lock, _appended);
+		std::string _tmp = _checkpoint_path() + ".tmp";
+		_avl_file _out;
+		_out.open(_tmp, true);
+		std::string _chunk(_magic, 8);
+		_avl_put_u64(_chunk, _tree.size());
+		std::uint32_t _crc = 0;
+		std::string _value;
+		for (auto& _v : _tree) {
+			_value.clear();
+			Codec::encode(_v, _value);
+			_avl_put_u32(_chunk, static_cast<std::uint32_t>(_value.size()));
+			_chunk += _value;
+			if (_chunk.size() >= (std::size_t(1) << 20)) {
+				_crc = _avl_crc32(_chunk.data(), _chunk.size(), _crc);
+				_out.write(_chunk.data(), _chunk.size());
+				_chunk.clear();
+			}
+		}
+		_crc = _avl_crc32(_chunk.data(), _chunk.size(), _crc);
+		_avl_put_u32(_chunk, _crc);
+		_out.write(_chunk.data(), _chunk.size());
+		_out.sync();
+		_out.close();
+		_avl_file::replace(_tmp, _checkpoint_path());
+		_wal.truncate(0);
+		_wal.sync();
+		_stats.log_bytes = 0;
+		_stats.checkpoints++;
+		_checkpoint_backoff = 0;
+	}
+
+	/*
+	 * _load_checkpoint
+	 * 㣬put_sortedO(n)ʱڴ
+	 * 㲻ʱ滻֮ǰµʱļֻʱʱΪա
+	 * 㱾ʱ׳std::runtime_error
+	 */
+	void _load_checkpoint() {
+		std::string _data;
+		bool _from_tmp = false;
+		if (!_avl_file::read_all(_checkpoint_path(), _data)) {
+			if (!_avl_file::read_all(_checkpoint_path() + ".tmp", _data))
+				return;
+			_from_tmp = true;
+		}
+		bool _valid = _data.size() >= 20 && !std::memcmp(_data.data(), _magic, 8) &&
+			_avl_get_u32(&_data[_data.size() - 4]) == _avl_crc32(_data.data(), _data.size() - 4);
+		if (!_valid) {
+			// ʱļ˵ʱδд꣬ʱ־Ȼ
+			if (_from_tmp)
+				return;
+			throw std::runtime_error("durable_avl: corrupted checkpoint " + _checkpoint_path());
+		}
+		std::uint64_t _count = _avl_get_u64(&_data[8]);
+		std::vector<T> _values;
+		_values.reserve(static_cast<std::size_t>(_count));
+		const char* _p = _data.data() + 16;
+		const char* _end = _data.data() + _data.size() - 4;
+		for (std::uint64_t _i = 0; _i < _count; _i++) {
+			if (_end - _p < 4)
+				throw std::runtime_error("durable_avl: corrupted checkpoint " + _checkpoint_path());
+			std::size_t _n = _avl_get_u32(_p);
+			_p += 4;
+			T _v{};
+			if (static_cast<std::size_t>(_end - _p) < _n || !Codec::decode(_p, _n, _v))
+				throw std::runtime_error("durable_avl: corrupted checkpoint " + _checkpoint_path());
+			_p += _n;
+			_values.push_back(std::move(_v));
+		}
+		_tree.put_sorted(_values.begin(), _values.end());
+	}
+
+	// _replayһ־¼򡢺ϲӦõϡ
+	void _replay(avl_delta<T>& _delta) {
+		_stats.replayed += _delta.changes.size();
+		_avl_merge_changes(_delta.changes, _comparator);
+		_tree.apply_delta(_delta);
+		_delta.changes.clear();
+	}
+
+	/*
+	 * _recover
+	 * 㣬ٰ˳ط־ȻCRCļ¼Ϊ־ĩβ
+	 * ȥݣʹ˺׷ӵļ¼һļ¼
+	 */
+	void _recover() {
+		_load_checkpoint();
+		std::string _data;
+		std::size_t _good = 0;
+		if (_avl_file::read_all(_wal_path(), _data)) {
+			avl_delta<T> _delta;
+			while (_data.size() - _good >= 9) {
+				const char* _p = _data.data() + _good;
+				std::size_t _n = _avl_get_u32(_p);
+				if (_data.size() - _good - 8 < _n || !_n || _avl_get_u32(_p + 4) != _avl_crc32(_p + 8, _n))
+					break;
+				T _v{};
+				if (!Codec::decode(_p + 9, _n - 1, _v))
+					throw std::runtime_error("durable_avl: undecodable record in " + _wal_path());
+				_delta.changes.push_back(avl_change<T>{ std::move(_v), _p[8] != 0 });
+				_good += 8 + _n;
+				if (_delta.changes.size() == _replay_batch)
+					_replay(_delta);
+			}
+			_replay(_delta);
+		}
+		_wal.open(_wal_path(), false);
+		if (_good != _data.size()) {
+			_wal.truncate(_good);
+			_wal.sync();
+		}
+		_stats.log_bytes = _good;
+	}
+
+public:
+	using size_type = std::size_t;
+
+	/*
+	 *	ӿڣ
+	 *	򿪣򴴽_prefixΪǰ׺ļлָ
+	 *	ָʱO(n + k log k)nΪеԪظkΪ־еļ¼
+	 *	
+	 *	_prefixļǰ׺ڵĿ¼Ѵڡ
+	 *	_opts־ûѡ
+	 *	_compȽдЩļʱʹõһ¡
+	 *	ļ޷дʱ׳std::system_errorʱ׳std::runtime_error
+	 */
+	explicit durable_avl(const std::string& _prefix, avl_durable_options _opts = avl_durable_options(), C _comp = C())
+		: _tree(_comp), _path(_prefix), _options(_opts), _comparator(_comp) {
+		_recover();
+	}
+
+	durable_avl(const durable_avl&) = delete;
+	durable_avl& operator=(const durable_avl&) = delete;
+
+	// ʱеļ¼̣ʧʱ׳쳣
+	~durable_avl() {
+		try {
+			sync();
+		}
+		catch (...) {
+		}
+	}
+
+	/*
+	 *	ӿڣputremove
+	 *	ɾһֵʵʷıʱ׷־¼
+	 *	ͬģʽڼ¼̺󷵻أõ̹߳һ̡
+	 *	ֵboolǷ˸ı䡣
+	 */
+	bool put(const T& _value) {
+		std::unique_lock<std::mutex> _lock(_mutex);
+		_check();
+		if (_tree.find(_value))
+			return false;
+		std::size_t _mark = _buffer.size();
+		auto _lsn = _append(_value, false);
+		try {
+			_tree.put(_value);
+		}
+		catch (...) {
+			_retract(_mark);
+			throw;
+		}
+		_commit(_lock, _lsn);
+		return true;
+	}
+
+	bool remove(const T& _value) {
+		std::unique_lock<std::mutex> _lock(_mutex);
+		_check();
+		if (!_tree.find(_value))
+			return false;
+		auto _lsn = _append(_value, true);
+		_tree.remove(_value);
+		_commit(_lock, _lsn);
+		return true;
+	}
+
+	bool find(const T& _value) const {
+		std::lock_guard<std::mutex> _lock(_mutex);
+		return _tree.find(_value);
+	}
+
+	/*
+	 *	ӿڣfor_each(F)
+	 *	Ƚ˳Ԫص_fڼ_fвõñĽӿڡ
+	 */
+	template <typename F>
+	void for_each(F _f) const {
+		std::lock_guard<std::mutex> _lock(_mutex);
+		for (auto& _value : _tree)
+			_f(_value);
+	}
+
+	size_type size() const {
+		std::lock_guard<std::mutex> _lock(_mutex);
+		return _tree.size();
+	}
+
+	bool empty() const {
+		return !size();
+	}
+
+	/*
+	 *	ӿڣsync()
+	 *	ʹǰ޸̣첽ģʽȷ־ûʱ㡣
+	 */
+	void sync() {
+		std::unique_lock<std::mutex> _lock(_mutex);
+		_wait(_lock, _appended);
+	}
+
+	/*
+	 *	ӿڣcheckpoint()
+	 *	д㲢ض־̴˺ָʱ䡣
+	 *	дʧʱ׳쳣Զд벻ͬ־
+	 */
+	void checkpoint() {
+		std::unique_lock<std::mutex> _lock(_mutex);
+		_check();
+		_checkpoint(_lock);
+	}
+
+	avl_durable_stats durability_stats() const {
+		std::lock_guard<std::mutex> _lock(_mutex);
+		return _stats;
+	}
+};
+
+template <typename T, typename C, typename S, typename B, typename Codec>
+constexpr char durable_avl<T, C, S, B, Codec>::_magic[9];
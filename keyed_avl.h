@@ -0,0 +1,477 @@
+/*
+	keyed_avl.h¼ֿŵAVL
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* Ԫǽϴļ¼ȴֻһСļȽʱ¼Ľڵ
+* ;ÿڵ㶼¼棬ڵڴҲŲúϡ衣
+* ڵֻŴӼ¼ȡļָ¼ָ룬
+* ¼һڵУֻʽյڵ㣬
+* ֱҵĿŷһμ¼Ȼ¼á
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename V, typename KeyOf, typename K, typename C, typename S, typename B>
+class keyed_avl;
+
+/*
+ * ݽṹ_keyed_avl_entry
+ * ڵдŵݡ
+ * Ա˵
+ * keyӼ¼ȡļ
+ * payloadָ¼ָ룬¼keyed_avlļ¼УʱʱΪա
+ */
+template <typename K, typename V>
+struct _keyed_avl_entry {
+	K key;
+	V* payload;
+};
+
+/*
+ * ݽṹ_keyed_avl_less
+ * ԼıȽȽ_keyed_avl_entry
+ */
+template <typename K, typename V, typename C>
+struct _keyed_avl_less {
+	C comparator;
+
+	bool operator()(const _keyed_avl_entry<K, V>& _lhs, const _keyed_avl_entry<K, V>& _rhs) const {
+		return comparator(_lhs.key, _rhs.key);
+	}
+};
+
+/*
+ *	class template _keyed_avl_iteratorkeyed_avl˫ֻܶȡ¼
+ *	װڲAVLĵʱɽڵеָʼ¼
+ */
+template <typename V, typename KeyOf, typename K, typename C, typename S, typename B>
+class _keyed_avl_iterator {
+	friend class keyed_avl<V, KeyOf, K, C, S, B>;
+
+private:
+	using _tree_iterator = typename avl<_keyed_avl_entry<K, V>, _keyed_avl_less<K, V, C>, S, B>::const_iterator;
+
+	// ˽ֶΣ_itڲAVLĵ
+	_tree_iterator _it;
+
+	explicit _keyed_avl_iterator(_tree_iterator _inner) : _it(_inner) {}
+
+public:
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = V;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const V*;
+	using reference = const V&;
+
+	_keyed_avl_iterator() = default;
+
+	const V& operator*() const {
+		return *_it->payload;
+	}
+
+	const V* operator->() const {
+		return _it->payload;
+	}
+
+	// ǰ¼ļȡʼ¼
+	const K& key() const {
+		return _it->key;
+	}
+
+	_keyed_avl_iterator& operator++() {
+		++_it;
+		return *this;
+	}
+
+	_keyed_avl_iterator operator++(int) {
+		auto _copy = *this;
+		++_it;
+		return _copy;
+	}
+
+	_keyed_avl_iterator& operator--() {
+		--_it;
+		return *this;
+	}
+
+	_keyed_avl_iterator operator--(int) {
+		auto _copy = *this;
+		--_it;
+		return _copy;
+	}
+
+	bool operator==(const _keyed_avl_iterator& _other) const {
+		return _it == _other._it;
+	}
+
+	bool operator!=(const _keyed_avl_iterator& _other) const {
+		return _it != _other._it;
+	}
+};
+
+/*
+ * ݽṹ_keyed_avl_key_type
+ * KeyOfconst V&ȡļͣȥconst
+ */
+template <typename V, typename KeyOf>
+struct _keyed_avl_key_type {
+	using type = typename std::decay<decltype(std::declval<const KeyOf&>()(std::declval<const V&>()))>::type;
+};
+
+/*
+ * class template keyed_avl¼ֿŵAVL
+ * ģ˵
+ * V¼͡
+ * KeyOfconst V&ȡĺ͡
+ * KͣĬΪKeyOfķֵ͡ᱻƵڵУӦСҸƵĴ۵͡
+ * ¼󲻵ƹ޸޸ļ¼ʹupdatemodify
+ * CSBıȽͳƲƽԣclass template avlͬ
+ * ڲAVL_keyed_avl_entry<K, V>ΪԪأĸʣָҡʾĲ룩
+ * ¼ӶĽڵз䣬ɾļ¼⣬¼ĵַڱֲ䡣
+ */
+template <typename V, typename KeyOf, typename K = typename _keyed_avl_key_type<V, KeyOf>::type,
+	typename C = std::less<K>, typename S = avl_no_stats, typename B = avl_strict_balance>
+class keyed_avl {
+private:
+	using _entry = _keyed_avl_entry<K, V>;
+	using _tree_type = avl<_entry, _keyed_avl_less<K, V, C>, S, B>;
+
+	// ˽ֶΣ_treeֻż¼ָAVL
+	_tree_type _tree;
+	// ˽ֶΣ_payloads¼أм¼з䡣
+	_avl_node_pool<V> _payloads;
+	// ˽ֶΣ_key_ofΪKeyOfȡĺ
+	KeyOf _key_of;
+	// ˽ֶΣ_comparatorΪCıȽһʵ
+	C _comparator;
+
+	// _probeڲ_keyʱԪء
+	static _entry _probe(const K& _key) {
+		return _entry{ _key, nullptr };
+	}
+
+	// _positionΪ_keyļ¼Ӧλãмȡļ¼ʱ_foundΪtrue
+	typename _tree_type::const_iterator _position(const K& _key, bool& _found) const {
+		auto _hint = _tree.lower_bound(_probe(_key));
+		_found = _hint != _tree.end() && !_comparator(_key, _hint->key);
+		return _hint;
+	}
+
+	/*
+	 * _new_payload_delete_payload
+	 * ڼ¼й¼׳쳣ʱ黹¼ۡ
+	 */
+	template <typename... A>
+	V* _new_payload(A&&... _args) {
+		void* _p = _payloads.allocate();
+		try {
+			return ::new (_p) V(std::forward<A>(_args)...);
+		}
+		catch (...) {
+			_payloads.deallocate(_p);
+			throw;
+		}
+	}
+
+	void _delete_payload(V* _p) {
+		_p->~V();
+		_payloads.deallocate(_p);
+	}
+
+	/*
+	 * _insert
+	 * ѹõļ¼_pУСȡļ׳쳣ʱ_p
+	 * ֵboolǷ_p
+	 */
+	bool _insert(V* _p) {
+		try {
+			K _key = _key_of(*_p);
+			bool _found;
+			auto _hint = _position(_key, _found);
+			if (!_found) {
+				_tree.put(_hint, _entry{ std::move(_key), _p });
+				return true;
+			}
+		}
+		catch (...) {
+			_delete_payload(_p);
+			throw;
+		}
+		_delete_payload(_p);
+		return false;
+	}
+
+	/*
+	 * _assign
+	 * _posָļ¼Ϊ_valueupdate(const_iterator, const V&)
+	 */
+	template <typename U>
+	_keyed_avl_iterator<V, KeyOf, K, C, S, B> _assign(_keyed_avl_iterator<V, KeyOf, K, C, S, B> _pos, U&& _value) {
+		V* _p = _pos._it->payload;
+		auto _it = _tree.update(_pos._it, _entry{ _key_of(_value), _p });
+		if (_it->payload != _p) {
+			_delete_payload(_p);
+			return _keyed_avl_iterator<V, KeyOf, K, C, S, B>(_it);
+		}
+		try {
+			*_p = std::forward<U>(_value);
+		}
+		catch (...) {
+			_tree.erase(_it);
+			_delete_payload(_p);
+			throw;
+		}
+		return _keyed_avl_iterator<V, KeyOf, K, C, S, B>(_it);
+	}
+
+	/*
+	 * _destroy_payloads
+	 * м¼ͷż¼أ޸
+	 */
+	void _destroy_payloads() {
+		if (!std::is_trivially_destructible<V>::value)
+			for (auto& _e : _tree)
+				_e.payload->~V();
+		_payloads.release();
+	}
+
+	// _copy_from˳_srcеļ¼׷ĩβ֤߱Ϊա
+	void _copy_from(const keyed_avl& _src) {
+		try {
+			for (auto& _e : _src._tree) {
+				V* _p = _new_payload(*_e.payload);
+				try {
+					_tree.put(_tree.end(), _entry{ _e.key, _p });
+				}
+				catch (...) {
+					_delete_payload(_p);
+					throw;
+				}
+			}
+		}
+		catch (...) {
+			_destroy_payloads();
+			_tree.clear();
+			throw;
+		}
+	}
+
+public:
+	using size_type = std::size_t;
+	using key_type = K;
+	using value_type = V;
+	using iterator = _keyed_avl_iterator<V, KeyOf, K, C, S, B>;
+	using const_iterator = iterator;
+
+	explicit keyed_avl(C _comp = C(), KeyOf _extract = KeyOf())
+		: _tree(_keyed_avl_less<K, V, C>{ _comp }), _key_of(_extract), _comparator(_comp) {}
+
+	/*
+	 *	ӿڣ캯뿽ֵ
+	 *	˳ÿ¼ʱO(n)
+	 */
+	keyed_avl(const keyed_avl& _src)
+		: _tree(_keyed_avl_less<K, V, C>{ _src._comparator }), _key_of(_src._key_of), _comparator(_src._comparator) {
+		_copy_from(_src);
+	}
+
+	keyed_avl& operator=(const keyed_avl& _src) {
+		if (this != &_src) {
+			keyed_avl _copy(_src);
+			swap(_copy);
+		}
+		return *this;
+	}
+
+	keyed_avl(keyed_avl&& _src) noexcept
+		: _tree(std::move(_src._tree)), _payloads(std::move(_src._payloads)), _key_of(_src._key_of), _comparator(_src._comparator) {}
+
+	keyed_avl& operator=(keyed_avl&& _src) noexcept {
+		if (this != &_src) {
+			clear();
+			swap(_src);
+		}
+		return *this;
+	}
+
+	~keyed_avl() {
+		_destroy_payloads();
+	}
+
+	void swap(keyed_avl& _other) noexcept {
+		std::swap(_tree, _other._tree);
+		_payloads.swap(_other._payloads);
+		std::swap(_key_of, _other._key_of);
+		std::swap(_comparator, _other._comparator);
+	}
+
+	/*
+	 *	ӿڣput(const V&)emplace(A&&...)
+	 *	һ¼ʱO(log n)мȡļ¼ֲ䡣
+	 *	putȷϼڣŸƼ¼emplaceȾ͵ع¼ȡü
+	 *	Ѵʱٽ١
+	 *	ֵboolǷ¼¼
+	 */
+	bool put(const V& _value) {
+		K _key = _key_of(_value);
+		bool _found;
+		auto _hint = _position(_key, _found);
+		if (_found)
+			return false;
+		V* _p = _new_payload(_value);
+		try {
+			_tree.put(_hint, _entry{ std::move(_key), _p });
+		}
+		catch (...) {
+			_delete_payload(_p);
+			throw;
+		}
+		return true;
+	}
+
+	template <typename... A>
+	bool emplace(A&&... _args) {
+		return _insert(_new_payload(std::forward<A>(_args)...));
+	}
+
+	/*
+	 *	ӿڣfindlocatelower_bound
+	 *	ңʱO(log n);ֻڵеļ
+	 *	locateָü¼ĵδҵʱβ
+	 *	lower_boundصһСڡ_keyļ¼
+	 */
+	bool find(const K& _key) const {
+		return _tree.find(_probe(_key));
+	}
+
+	const_iterator locate(const K& _key) const {
+		return const_iterator(_tree.locate(_probe(_key)));
+	}
+
+	const_iterator lower_bound(const K& _key) const {
+		return const_iterator(_tree.lower_bound(_probe(_key)));
+	}
+
+	/*
+	 *	ӿڣremove(const K&)erase(const_iterator)
+	 *	ɾΪ_keyļ¼ɾ_posָļ¼β
+	 *	removeǷɾ˼¼eraseָɾ¼ĺ̵ĵ
+	 */
+	bool remove(const K& _key) {
+		auto _it = _tree.locate(_probe(_key));
+		if (_it == _tree.end())
+			return false;
+		erase(const_iterator(_it));
+		return true;
+	}
+
+	iterator erase(const_iterator _pos) {
+		V* _p = _pos._it->payload;
+		auto _next = _tree.erase(_pos._it);
+		_delete_payload(_p);
+		return iterator(_next);
+	}
+
+	/*
+	 *	ӿڣupdate(const_iterator, const V&)modify(const_iterator, F)
+	 *	޸_posָļ¼¼ĵַ䡣λڼ¼֮ʱĽṹ䣬
+	 *	avl<T, C, S, B>::updateڵƶµλã˵
+	 *	ȡļ¼ɾ_posָļ¼бԭеļ¼
+	 *	modify_fn(V&)޸ļ¼һдأ_fn׳쳣ʱֲ䡣
+	 *	¼ĸֵ׳쳣ʱ_posָļ¼ɾ쳣⴫ݡ
+	 *	ֵiteratorָ¼¼ȡļ¼
+	 */
+	iterator update(const_iterator _pos, const V& _value) {
+		return _assign(_pos, _value);
+	}
+
+	template <typename F>
+	iterator modify(const_iterator _pos, F _fn) {
+		V _value(*_pos);
+		_fn(_value);
+		return _assign(_pos, std::move(_value));
+	}
+
+	/*
+	 *	ӿڣfront()back()
+	 *	ֵconst V&Сļ¼ʱO(1)
+	 *	Ϊʱûᵼ²ȷΪ
+	 */
+	const V& front() const {
+		return *_tree.front().payload;
+	}
+
+	const V& back() const {
+		return *_tree.back().payload;
+	}
+
+	size_type size() const {
+		return _tree.size();
+	}
+
+	bool empty() const {
+		return _tree.empty();
+	}
+
+	/*
+	 *	ӿڣclear()
+	 *	м¼¼صڴһͷš
+	 */
+	void clear() {
+		_destroy_payloads();
+		_tree.clear();
+	}
+
+	/*
+	 *	ӿڣtree()
+	 *	ֵconst avl<...>&ڲֻż¼ָAVLڲ鿴ͳϢȡ
+	 */
+	const _tree_type& tree() const {
+		return _tree;
+	}
+
+	/*
+	 *	ӿ壺beginend
+	 *	˳м¼
+	 */
+	const_iterator begin() const {
+		return const_iterator(_tree.begin());
+	}
+
+	const_iterator end() const {
+		return const_iterator(_tree.end());
+	}
+
+	const_iterator cbegin() const {
+		return begin();
+	}
+
+	const_iterator cend() const {
+		return end();
+	}
+};
@@ -0,0 +1,351 @@
+/*
+	sharded_avl.hƬĲ򼯺ϡ
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ롣
+* Programmed By Lucas.
+* ֵ佫ԪطֲɿAVLƬУÿƬԼĶд
+* ڲͬƬϵĲԲִС
+* ĳƬʱмһΪƬڷƬСʱϲ
+* Ƭı߽渺صı仯
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <vector>
+
+/*
+ * class template sharded_avlƬĲ򼯺ϡ
+ * ģclass template avlһ˴׸
+ * йӿھɶ̲߳á
+ * ͳƲSfind()ֻҲдSavl_no_statsʱ
+ * ͬռƬͬһƬϵĶٲС
+ * ˳ȲƬ˲
+ * ṩѯͨfor_eachfor_each_rangeɣ
+ * ڼ䰴˳иƬĶֹƬĵ
+ */
+template <typename T, typename C = std::less<T>, typename S = avl_no_stats, typename B = avl_strict_balance>
+class sharded_avl {
+private:
+	using _lock_type = std::shared_timed_mutex;
+	// еķƬռͳʱΪΪд
+	using _read_lock = typename std::conditional<std::is_same<S, avl_no_stats>::value,
+		std::shared_lock<_lock_type>, std::unique_lock<_lock_type>>::type;
+
+	/*
+	 * ݽṹ_shard
+	 * Ա˵
+	 * lockƬĶдҳж_read_lockɾд
+	 * treeƬеԪء
+	 */
+	struct _shard {
+		_lock_type lock;
+		avl<T, C, S, B> tree;
+		explicit _shard(const C& _comp) : tree(_comp) {}
+	};
+
+	// ˽ֶΣ_layoutԪصĲжƬʱд
+	mutable _lock_type _layout;
+	// ˽ֶΣ_shards˳еķƬ
+	std::vector<std::unique_ptr<_shard>> _shards;
+	// ˽ֶΣ_bounds_bounds[i]ǵi + 1Ƭ½磬0Ƭû½硣
+	std::vector<T> _bounds;
+	// ˽ֶΣ_sizeзƬԪ
+	std::atomic<std::size_t> _size{ 0 };
+	// ˽ֶΣ_targetķƬ
+	std::size_t _target;
+	// ˽ֶΣ_min_splitƬҪôԪزŻᱻһΪ
+	std::size_t _min_split;
+	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
+	C _comparator;
+
+	/*
+	 * _shard_of
+	 * в
+	 * ֵstd::size_t_valueƬ±ꡣ
+	 */
+	std::size_t _shard_of(const T& _value) const {
+		return static_cast<std::size_t>(std::upper_bound(_bounds.begin(), _bounds.end(), _value, _comparator) - _bounds.begin());
+	}
+
+	// _averageƬƽСķƬ㣩
+	std::size_t _average() const {
+		return _size.load(std::memory_order_relaxed) / _target;
+	}
+
+	// _too_large_too_smallжϴСΪ_nķƬǷҪָϲ
+	bool _too_large(std::size_t _n) const {
+		return _n > _min_split && _n > 2 * _average();
+	}
+
+	bool _too_small(std::size_t _n) const {
+		return _n < _average() / 4;
+	}
+
+	/*
+	 * _split_shard
+	 * _iƬмһΪвд
+	 */
+	void _split_shard(std::size_t _i) {
+		auto& _tree = _shards[_i]->tree;
+		auto _mid = _tree.begin();
+		std::advance(_mid, static_cast<std::ptrdiff_t>(_tree.size() / 2));
+		std::unique_ptr<_shard> _upper(new _shard(_comparator));
+		_upper->tree.put_sorted(_mid, _tree.end());
+		_bounds.insert(_bounds.begin() + static_cast<std::ptrdiff_t>(_i), *_mid);
+		try {
+			_shards.insert(_shards.begin() + static_cast<std::ptrdiff_t>(_i) + 1, std::move(_upper));
+		}
+		catch (...) {
+			_bounds.erase(_bounds.begin() + static_cast<std::ptrdiff_t>(_i));
+			throw;
+		}
+		_tree.erase(_mid, _tree.end());
+	}
+
+	/*
+	 * _merge_shards
+	 * _i + 1Ƭ_iƬвд
+	 */
+	void _merge_shards(std::size_t _i) {
+		auto& _upper = _shards[_i + 1]->tree;
+		_shards[_i]->tree.put_sorted(_upper.begin(), _upper.end());
+		_shards.erase(_shards.begin() + static_cast<std::ptrdiff_t>(_i) + 1);
+		_bounds.erase(_bounds.begin() + static_cast<std::ptrdiff_t>(_i));
+	}
+
+	/*
+	 * _rebalance
+	 * вдָķƬСķƬСڷƬ
+	 * ٺϲڷƬжϹСı׼removeı׼ͬ
+	 * ˵֮󲻻¹СķƬɾᷴд
+	 * ÿηָϲĺʱ漰ķƬСȡ
+	 */
+	void _rebalance() {
+		std::unique_lock<_lock_type> _guard(_layout);
+		for (std::size_t _i = 0; _i < _shards.size(); _i++)
+			while (_too_large(_shards[_i]->tree.size()))
+				_split_shard(_i);
+		for (std::size_t _i = 0; _shards.size() > 1 && _i < _shards.size();) {
+			if (!_too_small(_shards[_i]->tree.size())) {
+				_i++;
+				continue;
+			}
+			bool _left = _i + 1 == _shards.size() || (_i && _shards[_i - 1]->tree.size() <= _shards[_i + 1]->tree.size());
+			if (_left)
+				_i--;
+			_merge_shards(_i);
+		}
+		while (_shards.size() > 1) {
+			std::size_t _best = 0;
+			std::size_t _best_size = static_cast<std::size_t>(-1);
+			for (std::size_t _i = 0; _i + 1 < _shards.size(); _i++) {
+				std::size_t _n = _shards[_i]->tree.size() + _shards[_i + 1]->tree.size();
+				if (_n < _best_size) {
+					_best = _i;
+					_best_size = _n;
+				}
+			}
+			if (_shards.size() <= _target && _best_size >= _average() / 2)
+				break;
+			_merge_shards(_best);
+		}
+	}
+
+public:
+	using size_type = std::size_t;
+
+	/*
+	 *	ӿڣ
+	 *	ʼʱֻһƬԪص𲽷ָֱﵽķƬ
+	 *	
+	 *	_shard_countķƬͨȡ߳ɱ
+	 *	_compȽ
+	 */
+	explicit sharded_avl(size_type _shard_count = 16, C _comp = C())
+		: _target(_shard_count ? _shard_count : 1), _min_split(1024), _comparator(_comp) {
+		_shards.emplace_back(new _shard(_comparator));
+	}
+
+	/*
+	 *	ӿڣ
+	 *	ԸķƬ߽ʼֲ֪ĳϡ
+	 *	
+	 *	_initial_boundsȽϸеı߽磬ƬΪ߽1
+	 *	_compȽ
+	 */
+	explicit sharded_avl(std::vector<T> _initial_bounds, C _comp = C())
+		: _bounds(std::move(_initial_bounds)), _target(_bounds.size() + 1), _min_split(1024), _comparator(_comp) {
+		for (std::size_t _i = 0; _i < _target; _i++)
+			_shards.emplace_back(new _shard(_comparator));
+	}
+
+	sharded_avl(const sharded_avl&) = delete;
+	sharded_avl& operator=(const sharded_avl&) = delete;
+
+	/*
+	 *	ӿڣset_min_split(size_type)
+	 *	÷ƬָǰӦеԪĬΪ1024
+	 */
+	void set_min_split(size_type _n) {
+		std::unique_lock<_lock_type> _guard(_layout);
+		_min_split = _n;
+	}
+
+	/*
+	 *	ӿڣput
+	 *	һֵķƬƬ˹Ƭ
+	 *	
+	 *	_valueΪconst T&ֵ
+	 */
+	void put(const T& _value) {
+		bool _grown;
+		{
+			std::shared_lock<_lock_type> _guard(_layout);
+			auto& _s = *_shards[_shard_of(_value)];
+			std::unique_lock<_lock_type> _lock(_s.lock);
+			std::size_t _before = _s.tree.size();
+			_s.tree.put(_value);
+			_size.fetch_add(_s.tree.size() - _before, std::memory_order_relaxed);
+			_grown = _too_large(_s.tree.size());
+		}
+		if (_grown)
+			_rebalance();
+	}
+
+	/*
+	 *	ӿڣremove
+	 *	ķƬɾһֵƬ˹СƬ
+	 *	ֵboolָʾɾǷɹִС
+	 */
+	bool remove(const T& _value) {
+		bool _removed;
+		bool _shrunk;
+		{
+			std::shared_lock<_lock_type> _guard(_layout);
+			auto& _s = *_shards[_shard_of(_value)];
+			std::unique_lock<_lock_type> _lock(_s.lock);
+			_removed = _s.tree.remove(_value);
+			if (_removed)
+				_size.fetch_sub(1, std::memory_order_relaxed);
+			_shrunk = _removed && _shards.size() > 1 && _too_small(_s.tree.size());
+		}
+		if (_shrunk)
+			_rebalance();
+		return _removed;
+	}
+
+	/*
+	 *	ӿڣfind
+	 *	ķƬвһֵи÷ƬĶ_read_lock
+	 *	ֵboolʾǷҵ
+	 */
+	bool find(const T& _value) const {
+		std::shared_lock<_lock_type> _guard(_layout);
+		auto& _s = *_shards[_shard_of(_value)];
+		_read_lock _lock(_s.lock);
+		return _s.tree.find(_value);
+	}
+
+	/*
+	 *	ӿڣfor_each(F)
+	 *	Ƚ˳Ԫص_fγиƬĶ
+	 *	_fвõñĲɾ
+	 */
+	template <typename F>
+	void for_each(F _f) const {
+		std::shared_lock<_lock_type> _guard(_layout);
+		for (auto& _s : _shards) {
+			_read_lock _lock(_s->lock);
+			for (auto& _value : _s->tree)
+				_f(_value);
+		}
+	}
+
+	/*
+	 *	ӿڣfor_each_range(const T&, const T&, F)
+	 *	Ƚ˳[_low, _high)еԪص_fֻཻķƬ
+	 *	_fвõñĲɾ
+	 */
+	template <typename F>
+	void for_each_range(const T& _low, const T& _high, F _f) const {
+		std::shared_lock<_lock_type> _guard(_layout);
+		for (std::size_t _i = _shard_of(_low); _i < _shards.size(); _i++) {
+			if (_i && !_comparator(_bounds[_i - 1], _high))
+				break;
+			auto& _s = *_shards[_i];
+			_read_lock _lock(_s.lock);
+			auto _it = _s.tree.lower_bound(_low);
+			for (; _it != _s.tree.end() && _comparator(*_it, _high); ++_it)
+				_f(*_it);
+		}
+	}
+
+	/*
+	 *	ӿڣsize()empty()
+	 *	޸ʱصĳһʱ̸Ľֵ
+	 */
+	size_type size() const {
+		return _size.load(std::memory_order_relaxed);
+	}
+
+	bool empty() const {
+		return !size();
+	}
+
+	/*
+	 *	ӿڣshard_sizes()
+	 *	ֵstd::vector<size_type>˳еĸƬСڹ۲츺طֲ
+	 */
+	std::vector<size_type> shard_sizes() const {
+		std::shared_lock<_lock_type> _guard(_layout);
+		std::vector<size_type> _sizes;
+		for (auto& _s : _shards) {
+			std::shared_lock<_lock_type> _lock(_s->lock);
+			_sizes.push_back(_s->tree.size());
+		}
+		return _sizes;
+	}
+
+	/*
+	 *	ӿڣrebalance()
+	 *	ǰĸصƬֶͨá
+	 */
+	void rebalance() {
+		_rebalance();
+	}
+
+	/*
+	 *	ӿڣclear()
+	 *	зƬƬ߽籣ֲ䡣
+	 */
+	void clear() {
+		std::unique_lock<_lock_type> _guard(_layout);
+		for (auto& _s : _shards)
+			_s->tree.clear();
+		_size.store(0, std::memory_order_relaxed);
+	}
+};
@@ -0,0 +1,350 @@
+/*
+	static_avl.hڵ洢ڶڲ̶AVL
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ룬C++20ϵĻпڱڹ졣
+* Programmed By Lucas.
+* нڵڶڲУκζ̬ڴ䡣
+* 롢ֱʹavl.hAVL_CONSTEXPRεĺ㷨
+* C++20ڳֵдֲ÷constexpr
+* 첢ѯֲڱڼ̶ļƵ
+*
+*	constexpr bool table_ok() {
+*		static_avl<int, 4> table{ 7, 3, 11, 5 };
+*		return table.find(11) && !table.find(4);
+*	}
+*	static_assert(table_ok(), "");
+*
+* ļĩβ_static_avl_self_checkʽڱڲԱ
+* ռconstexprconstexpr static_avl<int, 4> table{ ... };Է
+* ֻݶΣҪڳֵ϶ڵַǿգGCCĬѡ½ܣ
+* -fsanitize=null-fsanitize=undefined-fno-delete-null-pointer-checksܾ
+*/
+
+#pragma once
+
+#include "avl.h"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+template <typename T, std::size_t N, typename C>
+class static_avl;
+
+/*
+ * ݽṹ_static_avl_node
+ * Աavl<T, C, S, B>ĽڵͬvalueԸֵԱԤȹõĽڵдԪء
+ */
+template <typename T>
+struct _static_avl_node {
+	T value{};
+	_static_avl_node* leftChild = nullptr;
+	_static_avl_node* rightChild = nullptr;
+	_static_avl_node* parent = nullptr;
+	std::ptrdiff_t factor = 0;
+};
+
+/*
+ *	class template _static_avl_iteratorstatic_avl˫ֻܶȡԪء
+ *	βݼõһԪء
+ */
+template <typename T, std::size_t N, typename C>
+class _static_avl_iterator {
+	friend class static_avl<T, N, C>;
+
+private:
+	using _node = _static_avl_node<T>;
+
+	// ˽ֶΣ_container
+	const static_avl<T, N, C>* _container;
+	// ˽ֶΣ_valueǰָĽڵ㣬Ϊʱʾβ
+	const _node* _value;
+
+	AVL_CONSTEXPR _static_avl_iterator(const static_avl<T, N, C>* _cont, const _node* _n) : _container(_cont), _value(_n) {}
+
+public:
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T*;
+	using reference = const T&;
+
+	AVL_CONSTEXPR _static_avl_iterator() : _container(nullptr), _value(nullptr) {}
+
+	AVL_CONSTEXPR const T& operator*() const {
+		return _value->value;
+	}
+
+	AVL_CONSTEXPR const T* operator->() const {
+		return &_value->value;
+	}
+
+	AVL_CONSTEXPR _static_avl_iterator& operator++() {
+		_value = _avl_successor(_value);
+		return *this;
+	}
+
+	AVL_CONSTEXPR _static_avl_iterator operator++(int) {
+		auto _copy = *this;
+		++*this;
+		return _copy;
+	}
+
+	AVL_CONSTEXPR _static_avl_iterator& operator--() {
+		if (_value)
+			_value = _avl_predecessor(_value);
+		else {
+			_value = _container->_root;
+			while (_value->rightChild)
+				_value = _value->rightChild;
+		}
+		return *this;
+	}
+
+	AVL_CONSTEXPR _static_avl_iterator operator--(int) {
+		auto _copy = *this;
+		--*this;
+		return _copy;
+	}
+
+	AVL_CONSTEXPR bool operator==(const _static_avl_iterator& _other) const {
+		return _value == _other._value;
+	}
+
+	AVL_CONSTEXPR bool operator!=(const _static_avl_iterator& _other) const {
+		return _value != _other._value;
+	}
+};
+
+/*
+ * class template static_avl̶AVL
+ * ģ˵
+ * TԪͣĬϹ뿽ֵڹʱ͡
+ * NܴŵԪظ
+ * CȽavl<T, C, S, B>ͬڹʱoperator()Ϊconstexpr
+ * ֲֻ֧ңֻĲұɾʹavl<T, C, S, B>
+ * ڵָ֮ƶʱڵе±¼ָ롣
+ * еָָconstexprʽĲұֻڲֱѡ¿
+ * ļͷ˵GCC 12ҲܾɺصĴ󣩣
+ * constexprڹľֲûЩơ
+ */
+template <typename T, std::size_t N, typename C = std::less<T>>
+class static_avl {
+	static_assert(N > 0, "static_avl: capacity must be positive");
+
+	friend class _static_avl_iterator<T, N, C>;
+
+private:
+	using _node = _static_avl_node<T>;
+
+	// ˽ֶΣ_nodesڵĴ洢ǰ_sizeڵѱʹá
+	_node _nodes[N];
+	// ˽ֶΣ_rootĸڵ㣬ΪʱΪա
+	_node* _root = nullptr;
+	// ˽ֶΣ_sizeԪصĸ
+	std::size_t _size = 0;
+	// ˽ֶΣ_comparatorΪC洢Ƚһʵ
+	C _comparator;
+
+	// _rebase_srcеĽڵָ뻻Ϊͬ±Ľڵ㡣
+	AVL_CONSTEXPR _node* _rebase(const static_avl& _src, const _node* _p) {
+		return _p ? _nodes + (_p - _src._nodes) : nullptr;
+	}
+
+	// _copy_from_srcʹõĽڵ㣬еָ롣
+	AVL_CONSTEXPR void _copy_from(const static_avl& _src) {
+		for (std::size_t _i = 0; _i < _src._size; _i++) {
+			_nodes[_i].value = _src._nodes[_i].value;
+			_nodes[_i].leftChild = _rebase(_src, _src._nodes[_i].leftChild);
+			_nodes[_i].rightChild = _rebase(_src, _src._nodes[_i].rightChild);
+			_nodes[_i].parent = _rebase(_src, _src._nodes[_i].parent);
+			_nodes[_i].factor = _src._nodes[_i].factor;
+		}
+		_root = _rebase(_src, _src._root);
+		_size = _src._size;
+		_comparator = _src._comparator;
+	}
+
+public:
+	using size_type = std::size_t;
+	using value_type = T;
+	using iterator = _static_avl_iterator<T, N, C>;
+	using const_iterator = iterator;
+
+	AVL_CONSTEXPR static_avl() : _nodes(), _comparator() {}
+
+	AVL_CONSTEXPR explicit static_avl(C _comp) : _nodes(), _comparator(_comp) {}
+
+	/*
+	 *	ӿڣ
+	 *	βʼб[_first, _last)еԪأȡԪֻһ
+	 *	Ԫظʱ׳std::length_errorڱڹʱΪ
+	 */
+	AVL_CONSTEXPR static_avl(std::initializer_list<T> _list, C _comp = C()) : _nodes(), _comparator(_comp) {
+		for (auto& _value : _list)
+			put(_value);
+	}
+
+	template <typename I>
+	AVL_CONSTEXPR static_avl(I _first, I _last, C _comp = C()) : _nodes(), _comparator(_comp) {
+		for (; _first != _last; ++_first)
+			put(*_first);
+	}
+
+	/*
+	 *	ӿڣ캯뿽ֵ
+	 *	ֻʹõĽڵ㣬ʱO(n)
+	 */
+	AVL_CONSTEXPR static_avl(const static_avl& _src) : _nodes(), _comparator(_src._comparator) {
+		_copy_from(_src);
+	}
+
+	AVL_CONSTEXPR static_avl& operator=(const static_avl& _src) {
+		if (this != &_src)
+			_copy_from(_src);
+		return *this;
+	}
+
+	/*
+	 *	ӿڣput
+	 *	һֵAVLʱO(log n)СȡԪأֲ䡣
+	 *	_valueʱ׳std::length_error
+	 *	ֵboolǷԪء
+	 */
+	AVL_CONSTEXPR bool put(const T& _value) {
+		_node* _parent = nullptr;
+		bool _left = false;
+		if (_avl_find_position(_root, _value, _comparator, _parent, _left))
+			return false;
+		if (_size == N)
+			throw std::length_error("static_avl: capacity exceeded");
+		auto _n = _nodes + _size++;
+		// ڵڿֵ֮ǰʹùȫֶΡ
+		_n->value = _value;
+		_n->leftChild = _n->rightChild = nullptr;
+		_n->parent = _parent;
+		_n->factor = 0;
+		if (!_parent)
+			_root = _n;
+		else if (_left)
+			_parent->leftChild = _n;
+		else
+			_parent->rightChild = _n;
+		avl_rotation _kind = avl_rotate_ll;
+		_avl_retrace_insert(_n, _root, _kind);
+		return true;
+	}
+
+	/*
+	 *	ӿڣfindlocate
+	 *	һֵʱO(log n)
+	 *	findǷҵlocateָԪصĵδҵʱβ
+	 */
+	AVL_CONSTEXPR bool find(const T& _value) const {
+		return _avl_find_node(static_cast<const _node*>(_root), _value, _comparator) != nullptr;
+	}
+
+	AVL_CONSTEXPR const_iterator locate(const T& _value) const {
+		return const_iterator(this, _avl_find_node(static_cast<const _node*>(_root), _value, _comparator));
+	}
+
+	/*
+	 *	ӿڣlower_bound(const T&)
+	 *	ֵconst_iteratorָһСڡ_valueԪأʱΪβ
+	 */
+	AVL_CONSTEXPR const_iterator lower_bound(const T& _value) const {
+		const _node* _result = nullptr;
+		for (const _node* _p = _root; _p;) {
+			if (_comparator(_p->value, _value))
+				_p = _p->rightChild;
+			else {
+				_result = _p;
+				_p = _p->leftChild;
+			}
+		}
+		return const_iterator(this, _result);
+	}
+
+	AVL_CONSTEXPR size_type size() const {
+		return _size;
+	}
+
+	AVL_CONSTEXPR bool empty() const {
+		return !_size;
+	}
+
+	static constexpr size_type capacity() {
+		return N;
+	}
+
+	/*
+	 *	ӿ壺beginend
+	 *	Ƚ˳Ԫء
+	 */
+	AVL_CONSTEXPR const_iterator begin() const {
+		const _node* _p = _root;
+		while (_p && _p->leftChild)
+			_p = _p->leftChild;
+		return const_iterator(this, _p);
+	}
+
+	AVL_CONSTEXPR const_iterator end() const {
+		return const_iterator(this, nullptr);
+	}
+
+	AVL_CONSTEXPR const_iterator cbegin() const {
+		return begin();
+	}
+
+	AVL_CONSTEXPR const_iterator cend() const {
+		return end();
+	}
+};
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+/*
+ * ڲԣ_static_avl_self_check
+ * ڳֵй졢Ʋһȷļͷ÷á
+ * ֵٲ룬ǸýڵΡ
+ */
+constexpr bool _static_avl_self_check() {
+	// ԪϸҸsize()һ¡
+	auto _sorted = [](const static_avl<int, 4>& _tree) {
+		std::size_t _count = 0;
+		int _prev = 0;
+		for (int _value : _tree) {
+			if (_count++ && _value <= _prev)
+				return false;
+			_prev = _value;
+		}
+		return _count == _tree.size();
+	};
+	static_avl<int, 4> _table{ 7, 3, 11, 5 };
+	if (!_sorted(_table) || _table.size() != 4 || !_table.find(11) || _table.find(4) || *_table.lower_bound(6) != 7)
+		return false;
+	auto _copy = _table;
+	_copy = static_avl<int, 4>{ 2 };
+	_copy.put(1);
+	_copy.put(3);
+	return _sorted(_copy) && _copy.size() == 3 && _table.find(5);
+}
+
+static_assert(_static_avl_self_check(), "static_avl: compile-time construction failed");
+#endif
@@ -0,0 +1,133 @@
+/*
+	defragment_test.cpp鷴ʹڵ
+	Copyright 2022 Lucas & yydk77.cn
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+* C++14ϵĻб뱾Դ룬磺
+* g++ -std=c++14 -O2 -I.. defragment_test.cpp -o defragment_test
+* Programmed By Lucas.
+* idle޸defragmentÿֽڵǡнڵ㣻
+* churnÿdefragment֮ɾڵʼղԪظĳ
+* еԪstd::setһ£
+* resetеһʱclear()relayout()ƶֵ֮Կʹá
+* ȫͨʱ0ʧܵļ鲢1
+*/
+
+#include "../avl.h"
+
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+
+namespace {
+
+	int _failures = 0;
+
+	void _check(bool _ok, const char* _what) {
+		if (!_ok) {
+			std::printf("FAILED: %s\n", _what);
+			_failures++;
+		}
+	}
+
+	bool _same(const avl<int>& _tree, const std::set<int>& _ref) {
+		if (_tree.size() != _ref.size())
+			return false;
+		auto _it = _ref.begin();
+		for (auto& _value : _tree)
+			if (_value != *_it++)
+				return false;
+		return true;
+	}
+
+	void _idle() {
+		avl<int> _tree;
+		for (int _i = 0; _i < 100000; _i++)
+			_tree.put(_i * 7 % 100003);
+		for (int _round = 0; _round < 6; _round++) {
+			while (_tree.defragment(1000))
+				;
+			_check(_tree.pool_capacity() == _tree.size(), "idle: pool holds exactly the tree after a round");
+			_check(_tree.locality().sequential == 1, "idle: nodes are contiguous after a round");
+		}
+	}
+
+	void _churn() {
+		std::mt19937 _gen(1);
+		avl<int> _tree;
+		std::set<int> _ref;
+		for (int _i = 0; _i < 50000; _i++) {
+			int _value = static_cast<int>(_gen() % 200000);
+			_tree.put(_value);
+			_ref.insert(_value);
+		}
+		std::size_t _peak = 0;
+		for (int _round = 0; _round < 20; _round++) {
+			while (_tree.defragment(500)) {
+				for (int _k = 0; _k < 50; _k++) {
+					int _value = static_cast<int>(_gen() % 200000);
+					if (_gen() & 1) {
+						_tree.put(_value);
+						_ref.insert(_value);
+					}
+					else {
+						_tree.remove(_value);
+						_ref.erase(_value);
+					}
+				}
+				if (_tree.pool_capacity() > _peak)
+					_peak = _tree.pool_capacity();
+			}
+		}
+		_check(_peak <= 4 * _ref.size(), "churn: pool stays within a constant factor of the tree");
+		_check(_same(_tree, _ref), "churn: elements survive defragmentation");
+	}
+
+	void _reset() {
+		std::set<int> _ref;
+		avl<int> _tree;
+		for (int _i = 0; _i < 10000; _i++) {
+			_tree.put(_i);
+			_ref.insert(_i);
+		}
+		_tree.defragment(3000);
+		_tree.clear();
+		_check(_tree.empty() && _tree.pool_capacity() == 0, "reset: clear() releases both pools");
+		for (int _i = 0; _i < 10000; _i++)
+			_tree.put(_i);
+		_tree.defragment(3000);
+		_tree.relayout();
+		_check(_same(_tree, _ref) && _tree.pool_capacity() == _ref.size(), "reset: relayout() during a round");
+		_tree.defragment(3000);
+		avl<int> _other;
+		_other = std::move(_tree);
+		_check(_same(_other, _ref), "reset: move assignment during a round");
+		while (_other.defragment(1000))
+			;
+		_check(_other.pool_capacity() == _ref.size(), "reset: a new round after move assignment");
+	}
+
+}
+
+int main() {
+	_idle();
+	_churn();
+	_reset();
+	if (!_failures)
+		std::printf("all checks passed\n");
+	return _failures ? 1 : 0;
+}